@@ -15,6 +15,7 @@
 #include <functional>
 #include <iostream>
 #include <limits>
+#include <map>
 #include <random>
 #include <sstream>
 #include <stdexcept>
@@ -91,6 +92,18 @@ struct Test
 	uint32_t allowedErrorInUlp;
 	std::string sourceFile;
 	std::vector<Range> ranges;
+	// additional compilation options, e.g. to select the function for generic kernel sources
+	std::string compileOptions = "";
+	// allowed errors for single kernels (by kernel name) deviating from the allowed error for the whole test
+	std::map<std::string, uint32_t> kernelErrorInUlp = {};
+	// argument lists of edge cases, which are tested in addition to the values generated for every range
+	std::vector<std::vector<float>> specialInputs = {};
+
+	uint32_t getAllowedErrorInUlp(const std::string &kernelName) const
+	{
+		auto it = kernelErrorInUlp.find(kernelName);
+		return it != kernelErrorInUlp.end() ? it->second : allowedErrorInUlp;
+	}
 };
 
 static float identity(float val)
@@ -98,6 +111,11 @@ static float identity(float val)
 	return val;
 }
 
+static float rsqrt(float val)
+{
+	return static_cast<float>(1.0 / std::sqrt(static_cast<double>(val)));
+}
+
 // XXX OpenCL-CTS calculates reference in double, thus is more accurate. So tests being accurate here might not be in
 // the CTS!
 static const std::vector<Test> floatTests = {
@@ -106,6 +124,49 @@ static const std::vector<Test> floatTests = {
 			{0.5, 1.0}, // reduced range some implementations use
 			{std::numeric_limits<float>::min(), std::numeric_limits<float>::max()} // full range
 		}},
+	// the candidates for the logarithm, each run next to the builtin log()
+	Test{"log_taylor", logf, 4, "log.cl",
+		{
+			{0.5, 1.0}, // reduced range some implementations use
+			{std::numeric_limits<float>::min(), std::numeric_limits<float>::max()} // full range
+		},
+		"-DCANDIDATE=log_taylor"},
+	Test{"log1p_taylor", logf, 4, "log.cl",
+		{
+			{0.5, 1.0}, // reduced range some implementations use
+			{std::numeric_limits<float>::min(), std::numeric_limits<float>::max()} // full range
+		},
+		"-DCANDIDATE=log1p_taylor"},
+	Test{"log1p_taylor_unrolled", logf, 4, "log.cl",
+		{
+			{0.5, 1.0}, // reduced range some implementations use
+			{std::numeric_limits<float>::min(), std::numeric_limits<float>::max()} // full range
+		},
+		"-DCANDIDATE=log1p_taylor_unrolled"},
+	Test{"log_agm", logf, 4, "log.cl",
+		{
+			{0.5, 1.0}, // reduced range some implementations use
+			{std::numeric_limits<float>::min(), std::numeric_limits<float>::max()} // full range
+		},
+		"-DCANDIDATE=log_agm"},
+	Test{"log_agm_reduced", logf, 4, "log.cl",
+		{
+			{0.5, 1.0}, // reduced range some implementations use
+			{std::numeric_limits<float>::min(), std::numeric_limits<float>::max()} // full range
+		},
+		"-DCANDIDATE=log_agm_reduced"},
+	Test{"log_pade", logf, 4, "log.cl",
+		{
+			{0.5, 1.0}, // reduced range some implementations use
+			{std::numeric_limits<float>::min(), std::numeric_limits<float>::max()} // full range
+		},
+		"-DCANDIDATE=log_pade"},
+	Test{"log_chebyshev", logf, 4, "log.cl",
+		{
+			{0.5, 1.0}, // reduced range some implementations use
+			{std::numeric_limits<float>::min(), std::numeric_limits<float>::max()} // full range
+		},
+		"-DCANDIDATE=log_chebyshev"},
 	Test{"exp", expf, 4, "exp.cl",
 		{
 			{0.0, 0.5f * logf(2.0f)}, // reduced range some implementations use
@@ -115,15 +176,64 @@ static const std::vector<Test> floatTests = {
 		{
 			{-10.0f, 10.0f}, {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::max()} // full range
 		}},
-	Test{"cbrt", cbrtf, 4, "cbrt.cl",
+	Test{"cbrt", cbrtf, 2, "cbrt.cl",
 		{
 			{-1.0, 1.0}, // limited range for precision testing
+			{1.0f, 8.0f}, // single period of the exponent division
 			{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::max()} // full range
 		}},
+	// the half and native versions are allowed an error of up to 8192 ULP, see VC4CL_MATH_ACCURACY
+	Test{"sin", sinf, 4, "variants.cl",
+		{
+			{-M_PI_4, M_PI_4}, // no argument reduction
+			{-65536.0f, 65536.0f} // range required for the half versions
+		},
+		"-DFUNC=sin", {{"sin_half_kernel", 8192}, {"sin_native_kernel", 8192}}},
+	Test{"cos", cosf, 4, "variants.cl",
+		{
+			{-M_PI_4, M_PI_4}, // no argument reduction
+			{-65536.0f, 65536.0f} // range required for the half versions
+		},
+		"-DFUNC=cos", {{"cos_half_kernel", 8192}, {"cos_native_kernel", 8192}}},
+	Test{"tan", tanf, 4, "variants.cl",
+		{
+			{-M_PI_4, M_PI_4}, // no argument reduction
+			{-65536.0f, 65536.0f} // range required for the half versions
+		},
+		"-DFUNC=tan", {{"tan_half_kernel", 8192}, {"tan_native_kernel", 8192}}},
+	// the accuracy tiers of the square root functions, see vc4cl_rsqrt_step, the native versions only use the SFU
+	// approximation (relative error of up to 2^-11)
+	Test{"sqrt", sqrtf, 0, "variants.cl",
+		{
+			{1.0f, 4.0f}, // single period of the exponent
+			{0.0f, std::numeric_limits<float>::max()} // full range
+		},
+		"-DFUNC=sqrt", {{"sqrt_half_kernel", 8}, {"sqrt_native_kernel", 8192}}},
+	Test{"rsqrt", rsqrt, 1, "variants.cl",
+		{
+			{1.0f, 4.0f}, // single period of the exponent
+			{std::numeric_limits<float>::min(), std::numeric_limits<float>::max()} // full range
+		},
+		"-DFUNC=rsqrt", {{"rsqrt_half_kernel", 8}, {"rsqrt_native_kernel", 8192}}},
 	Test{"fma", fmaf, 0, "fma.cl",
 		{
 			{-100.0f, 100.0f}, // reduced range to not run into NaN/Inf
 			{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::max()} // full range
+		},
+		"", {},
+		{
+			{0x1.0p64f, 0x1.0p64f, std::numeric_limits<float>::lowest()} // product overflows, but the sum is finite
+		}},
+	// the independently generated arguments mix elements with x < y and x > y in every vector
+	Test{"fmod", fmodf, 0, "fmod.cl",
+		{
+			{-100.0f, 100.0f}, // few steps of the long division
+			{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::max()} // full range
+		},
+		"", {},
+		{
+			{1.5f, 2.0f}, {100.0f, 3.0f}, // smaller exponent, but larger mantissa of x next to a larger exponent
+			{std::numeric_limits<float>::max(), std::numeric_limits<float>::denorm_min()} // maximum number of steps
 		}}};
 
 static std::vector<float> generateInputData(const Range &range, uint32_t numLinear, uint32_t numRandom)
@@ -153,6 +263,20 @@ static std::vector<std::vector<float>> generateInputData(
 	return data;
 }
 
+static void appendSpecialInputs(
+	std::vector<std::vector<float>> &inputs, const std::vector<std::vector<float>> &specialInputs)
+{
+	if(specialInputs.empty())
+		return;
+	// the special inputs are repeated to fill up the last work-item
+	auto numValues = (inputs.front().size() + specialInputs.size() + 15) / 16 * 16;
+	for(std::size_t i = 0; inputs.front().size() < numValues; ++i)
+	{
+		for(std::size_t param = 0; param < inputs.size(); ++param)
+			inputs[param].push_back(specialInputs[i % specialInputs.size()].at(param));
+	}
+}
+
 static std::vector<cl::Kernel> createKernels(const cl::Context &context, const Test &test)
 {
 	std::stringstream ss;
@@ -160,7 +284,8 @@ static std::vector<cl::Kernel> createKernels(const cl::Context &context, const T
 		std::ifstream fis{test.sourceFile};
 		ss << fis.rdbuf();
 	}
-	cl::Program program(context, ss.str(), true);
+	cl::Program program(context, ss.str());
+	program.build(test.compileOptions.c_str());
 
 	std::vector<cl::Kernel> kernels;
 	program.createKernels(&kernels);
@@ -267,6 +392,7 @@ static void runTest(
 	for(const auto &range : test.ranges)
 	{
 		auto inputs = generateInputData(range, numLinear, numRandom, test.reference.numParameters);
+		appendSpecialInputs(inputs, test.specialInputs);
 		auto inputSize = inputs.front().size();
 		cl::NDRange globalSize(inputSize / 16);
 		std::vector<float> reference = test.reference(inputs);
@@ -282,7 +408,11 @@ static void runTest(
 			for(std::size_t i = 0; i < inputBuffers.size(); ++i)
 				kernel.setArg(1 + i, inputBuffers[i]);
 
-			std::cout << "\tRunning kernel '" << kernel.getInfo<CL_KERNEL_FUNCTION_NAME>() << "' with "
+			auto kernelName = kernel.getInfo<CL_KERNEL_FUNCTION_NAME>();
+			// some implementations include the terminating null character in the returned name
+			kernelName.erase(std::find(kernelName.begin(), kernelName.end(), '\0'), kernelName.end());
+			auto allowedErrorInUlp = test.getAllowedErrorInUlp(kernelName);
+			std::cout << "\tRunning kernel '" << kernelName << "' with "
 					  << (inputSize / 16) << " work-items ... " << std::endl;
 			auto start = std::chrono::steady_clock::now();
 			cl::Event kernelEvent{};
@@ -310,9 +440,9 @@ static void runTest(
 
 			std::vector<float> result(inputSize);
 			queue.enqueueReadBuffer(outputBuffer, CL_TRUE, 0, inputSize * sizeof(float), result.data());
-			auto errors = checkResults(inputs, reference, result, test.allowedErrorInUlp);
+			auto errors = checkResults(inputs, reference, result, allowedErrorInUlp);
 			std::cout << "\t- Has " << errors.first.size() << " wrong results and a maximum error of " << errors.second
-					  << " ULP (of allowed " << test.allowedErrorInUlp << " ULP)" << std::endl;
+					  << " ULP (of allowed " << allowedErrorInUlp << " ULP)" << std::endl;
 			for(std::size_t i = 0; i < std::min(errors.first.size(), std::size_t{8}); ++i)
 				std::cout << "\t\t" << errors.first[i] << std::endl;
 			if(errors.first.size() > 8)
@@ -0,0 +1,8 @@
+#define arg_t float16
+#define result_t float16
+
+__kernel void fmod_builtin_kernel(__global result_t *out, const __global arg_t *in0, const __global arg_t *in1)
+{
+	uint gid = get_global_id(0);
+	out[gid] = fmod(in0[gid], in1[gid]);
+}
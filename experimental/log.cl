@@ -1,3 +1,8 @@
+/*
+ * Candidate implementations for the logarithm. The candidate to compare against the builtin log() is selected by
+ * compiling with -DCANDIDATE=<name>, e.g. -DCANDIDATE=log_taylor generates the kernels log_taylor_kernel and
+ * log_builtin_kernel.
+ */
 #define arg_t float16
 #define result_t float16
 #define int_t int16
@@ -46,24 +51,19 @@ result_t log1p_taylor(arg_t val)
 	REDUCE_ARGUMENT_TO_0_1
 
 	// iteration 1
-	result_t result = mantissa;
-	arg_t power = mantissa;
+	arg_t x = mantissa - (arg_t) 1.0f;
+	result_t result = x;
+	arg_t power = x;
 #pragma loop unroll
 	for(unsigned iteration = 2; iteration <= 26; ++iteration) // TODO can adjust number of iterations
 	{
-		power *= mantissa;
+		power *= x;
 		arg_t sign = iteration & 1 ? (arg_t) 1.0 : (arg_t) -1.0;
 		result = result + sign * (arg_t) (1.0 / iteration) * power;
 	}
 	return result + reduced;
 }
 
-__kernel void log1p_taylor_kernel(__global arg_t *out, const __global arg_t *in)
-{
-	uint gid = get_global_id(0);
-	out[gid] = log1p_taylor(in[gid] - (arg_t) 1.0f);
-}
-
 result_t log1p_taylor_unrolled(arg_t val)
 {
 	// ln (1 + x) = x - x^2/2 + x^3/3 - x^4/4
@@ -72,107 +72,108 @@ result_t log1p_taylor_unrolled(arg_t val)
 	REDUCE_ARGUMENT_TO_0_1
 
 	// iteration 1
-	result_t result = mantissa;
-	arg_t power = mantissa;
+	arg_t x = mantissa - (arg_t) 1.0f;
+	result_t result = x;
+	arg_t power = x;
 
 	// iteration 2
-	power *= mantissa;
+	power *= x;
 	result = result - (arg_t) (1.0 / 2.0) * power;
 
 	// iteration 3
-	power *= mantissa;
+	power *= x;
 	result = result + (arg_t) (1.0 / 3.0) * power;
 
 	// iteration 4
-	power *= mantissa;
+	power *= x;
 	result = result - (arg_t) (1.0 / 4.0) * power;
 
 	// iteration 5
-	power *= mantissa;
+	power *= x;
 	result = result + (arg_t) (1.0 / 5.0) * power;
 
 	// iteration 6
-	power *= mantissa;
+	power *= x;
 	result = result - (arg_t) (1.0 / 6.0) * power;
 
 	// iteration 7
-	power *= mantissa;
+	power *= x;
 	result = result + (arg_t) (1.0 / 7.0) * power;
 
 	// iteration 8
-	power *= mantissa;
+	power *= x;
 	result = result - (arg_t) (1.0 / 8.0) * power;
 
 	// iteration 9
-	power *= mantissa;
+	power *= x;
 	result = result + (arg_t) (1.0 / 9.0) * power;
 
 	// iteration 10
-	power *= mantissa;
+	power *= x;
 	result = result - (arg_t) (1.0 / 10.0) * power;
 
 	// iteration 11
-	power *= mantissa;
+	power *= x;
 	result = result + (arg_t) (1.0 / 11.0) * power;
 
 	// iteration 12
-	power *= mantissa;
+	power *= x;
 	result = result - (arg_t) (1.0 / 12.0) * power;
 
 	// iteration 13
-	power *= mantissa;
+	power *= x;
 	result = result + (arg_t) (1.0 / 13.0) * power;
 
 	// iteration 14
-	power *= mantissa;
+	power *= x;
 	result = result - (arg_t) (1.0 / 14.0) * power;
 
 	// iteration 15
-	power *= mantissa;
+	power *= x;
 	result = result + (arg_t) (1.0 / 15.0) * power;
 
 	// iteration 16
-	power *= mantissa;
+	power *= x;
 	result = result - (arg_t) (1.0 / 16.0) * power;
 
 	// iteration 17
-	power *= mantissa;
+	power *= x;
 	result = result + (arg_t) (1.0 / 17.0) * power;
 
 	// iteration 18
-	power *= mantissa;
+	power *= x;
 	result = result - (arg_t) (1.0 / 18.0) * power;
 
 	// iteration 19
-	power *= mantissa;
+	power *= x;
 	result = result + (arg_t) (1.0 / 19.0) * power;
 
 	// iteration 20
-	power *= mantissa;
+	power *= x;
 	result = result - (arg_t) (1.0 / 20.0) * power;
 
 	// iteration 21
-	power *= mantissa;
+	power *= x;
 	result = result + (arg_t) (1.0 / 21.0) * power;
 
 	// iteration 22
-	power *= mantissa;
+	power *= x;
 	result = result - (arg_t) (1.0 / 22.0) * power;
 
 	// iteration 23
-	power *= mantissa;
+	power *= x;
 	result = result + (arg_t) (1.0 / 23.0) * power;
 
 	// iteration 24
-	power *= mantissa;
+	power *= x;
 	result = result - (arg_t) (1.0 / 24.0) * power;
 
 	// iteration 25
-	power *= mantissa;
+	power *= x;
 	result = result + (arg_t) (1.0 / 25.0) * power;
 
 	// iteration 26
-	power *= mantissa;
+	power *= x;
 	result = result - (arg_t) (1.0 / 26.0) * power;
 
 	// TODO can adjust number of iterations
@@ -180,12 +181,6 @@ result_t log1p_taylor_unrolled(arg_t val)
 	return result + reduced;
 }
 
-__kernel void log1p_taylor_unrolled_kernel(__global arg_t *out, const __global arg_t *in)
-{
-	uint gid = get_global_id(0);
-	out[gid] = log1p_taylor_unrolled(in[gid] - (arg_t) 1.0f);
-}
-
 /*
  * Taylor series with optimization, requires argument reduction,
  *
@@ -195,9 +190,10 @@ result_t log_taylor(arg_t val)
 {
 	REDUCE_ARGUMENT_TO_0_1
 
+	// log(x) = 2 * atanh((x - 1) / (x + 1)) = 2 * (y + y^3/3 + y^5/5 + ...)
 	result_t result = 0;
 	// iteration 1
-	arg_t tmp = 2 * (mantissa - (arg_t) 1.0) / (mantissa + (arg_t) 1.0);
+	arg_t tmp = (mantissa - (arg_t) 1.0) / (mantissa + (arg_t) 1.0);
 	arg_t factor = tmp * tmp;
 #pragma loop unroll
 	for(unsigned iteration = 1; iteration <= 26; iteration += 2) // TODO can adjust number of iterations
@@ -205,13 +201,7 @@ result_t log_taylor(arg_t val)
 		result += tmp / (arg_t) iteration;
 		tmp *= factor;
 	}
-	return result + reduced;
-}
-
-__kernel void log_taylor_kernel(__global arg_t *out, const __global arg_t *in)
-{
-	uint gid = get_global_id(0);
-	out[gid] = log_taylor(in[gid]);
+	return 2 * result + reduced;
 }
 
 /*
@@ -221,34 +211,78 @@ __kernel void log_taylor_kernel(__global arg_t *out, const __global arg_t *in)
  */
 result_t log_agm(arg_t val)
 {
-	const unsigned m = 8; // TODO can adjust for precision
+	// log(x) ~ pi / (2 * agm(1, 4 / s)) - m * log(2) with s = x * 2^m > 2^(p/2)
+	const unsigned m = 16; // TODO can adjust for precision
 	arg_t s = val * (arg_t) (1 << m);
 	arg_t mean = agm(1.0, (arg_t) 4.0 / s);
-	return (val * M_PI_F) / (2 * mean) - (arg_t) (m * M_LN2);
-}
-
-__kernel void log_agm_kernel(__global arg_t *out, const __global arg_t *in)
-{
-	uint gid = get_global_id(0);
-	out[gid] = log_agm(in[gid]);
+	return M_PI_F / (2 * mean) - (arg_t) (m * M_LN2);
 }
 
 result_t log_agm_reduced(arg_t val)
 {
 	REDUCE_ARGUMENT_TO_0_1
 
-	const unsigned m = 8; // TODO can adjust for precision
+	const unsigned m = 16; // TODO can adjust for precision
 	arg_t s = mantissa * (arg_t) (1 << m);
 	arg_t mean = agm(1.0, (arg_t) 4.0 / s);
-	return (mantissa * M_PI_F) / (2 * mean) - (arg_t) (m * M_LN2) + reduced;
+	return M_PI_F / (2 * mean) - (arg_t) (m * M_LN2) + reduced;
+}
+
+/*
+ * Pade approximation of log(1 + x) with argument reduction (previously used by the builtin functions),
+ *
+ * https://ir.canterbury.ac.nz/bitstream/handle/10092/8886/brookes_thesis.pdf?sequence=1, page 72/96
+ */
+result_t log_pade(arg_t val)
+{
+	REDUCE_ARGUMENT_TO_0_1
+
+	// g(x) = (49x^6+1218x^5+7980x^4+20720x^3+23100x^2+9240x)/(10x^6+420x^5+4200x^4+16800x^3+31500x^2+27720x+9240)
+	arg_t x = mantissa - (arg_t) 1.0f;
+	arg_t up = x * ((arg_t) 9240.0f + x * ((arg_t) 23100.0f + x * ((arg_t) 20720.0f + x * ((arg_t) 7980.0f +
+		x * ((arg_t) 1218.0f + x * (arg_t) 49.0f)))));
+	arg_t down = (arg_t) 9240.0f + x * ((arg_t) 27720.0f + x * ((arg_t) 31500.0f + x * ((arg_t) 16800.0f +
+		x * ((arg_t) 4200.0f + x * ((arg_t) 420.0f + x * (arg_t) 10.0f)))));
+	return up / down + reduced;
+}
+
+/*
+ * Chebyshev expansion of log(x) on [0.5, 1) with argument reduction, evaluated with the Clenshaw recurrence,
+ *
+ * https://en.wikipedia.org/wiki/Clenshaw_algorithm
+ */
+result_t log_chebyshev(arg_t val)
+{
+	REDUCE_ARGUMENT_TO_0_1
+
+	// coefficients c_0 to c_11 of log((t + 3) / 4) for t = 4x - 3 in [-1, 1), |c_12| ~ 1e-10
+	const float coefficients[12] = {-0x1.444b88p-2f, 0x1.5f619ap-2f, -0x1.e24cc8p-6f, 0x1.b954c4p-9f, -0x1.c6529cp-12f,
+		0x1.f2e062p-15f, -0x1.1d4ff0p-17f, 0x1.4fab76p-20f, -0x1.93248ep-23f, 0x1.ebdd2cp-26f, -0x1.2fce4cp-28f,
+		0x1.7b16f4p-31f};
+	arg_t t = (arg_t) 4.0f * mantissa - (arg_t) 3.0f;
+	arg_t b1 = 0;
+	arg_t b2 = 0;
+#pragma loop unroll
+	for(int i = 11; i >= 1; --i)
+	{
+		arg_t b0 = (arg_t) coefficients[i] + (arg_t) 2.0f * t * b1 - b2;
+		b2 = b1;
+		b1 = b0;
+	}
+	return ((arg_t) coefficients[0] + t * b1 - b2) + reduced;
 }
 
-__kernel void log_agm_reduced_kernel(__global arg_t *out, const __global arg_t *in)
+#ifdef CANDIDATE
+__kernel void CAT(CANDIDATE, _kernel)(__global arg_t *out, const __global arg_t *in)
 {
 	uint gid = get_global_id(0);
-	out[gid] = log_agm_reduced(in[gid]);
+	out[gid] = CANDIDATE(in[gid]);
 }
+#endif
 
+/*
+ * The builtin log() is derived from the table-driven extended precision log2 core (vc4cl_log2_extended)
+ */
 __kernel void log_builtin_kernel(__global arg_t *out, const __global arg_t *in)
 {
 	uint gid = get_global_id(0);
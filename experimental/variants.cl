@@ -0,0 +1,20 @@
+/*
+ * Compares the full precision builtin with its half_ and native_ versions. The function is selected by compiling with
+ * -DFUNC=<name>, e.g. -DFUNC=sin generates the kernels sin_builtin_kernel, sin_half_kernel and sin_native_kernel.
+ */
+#define arg_t float16
+#define result_t float16
+
+#define CONCAT(a, b) a##b
+#define CAT(a, b) CONCAT(a, b)
+
+#define VARIANT_KERNEL(suffix, func) \
+	__kernel void CAT(FUNC, suffix)(__global result_t *out, const __global arg_t *in) \
+	{ \
+		uint gid = get_global_id(0); \
+		out[gid] = func(in[gid]); \
+	}
+
+VARIANT_KERNEL(_builtin_kernel, FUNC)
+VARIANT_KERNEL(_half_kernel, CAT(half_, FUNC))
+VARIANT_KERNEL(_native_kernel, CAT(native_, FUNC))
@@ -19,6 +19,7 @@ extern "C"
 #include "_conversions.h"
 #include "_common.h"
 #include "_math.h"
+#include "_double.h"
 #include "_integer.h"
 #include "_geometric.h"
 #include "_relational.h"
@@ -61,6 +62,7 @@ extern "C"
 #undef COMPLEX_1
 #undef COMPLEX_1_RETURN_SCALAR
 #undef COMPLEX_2
+#undef COMPLEX_2_SCALAR
 #undef COMPLEX_3
 #undef COMPLEX_3_SCALAR
 #undef OVERLOAD_ALL_IMAGE_TYPES
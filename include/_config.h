@@ -26,5 +26,54 @@
 
 #define ALL_BITS_SET 0xFFFFFFFFU
 
+/*
+ * Relaxed math mode
+ *
+ * Compiling with -cl-fast-relaxed-math (which defines __FAST_RELAXED_MATH__) allows the math functions to be less
+ * accurate and makes NaN and Inf arguments and results undefined. In this mode, the full precision math functions are
+ * mapped to their native_ versions and the special-case handling for NaN and Inf arguments is skipped.
+ *
+ * Since -cl-unsafe-math-optimizations does not define any macro, the compiler can enable this mode by defining
+ * VC4CL_RELAXED_MATH directly.
+ */
+#if defined(__FAST_RELAXED_MATH__) && !defined(VC4CL_RELAXED_MATH)
+#define VC4CL_RELAXED_MATH 1
+#endif
+
+/*
+ * Accuracy tiers
+ *
+ * Defining VC4CL_MATH_ACCURACY to a maximum error (in ULP) selects faster implementations for some of the full
+ * precision math functions, as long as their maximum error (tested on host) does not exceed the given budget:
+ *
+ * function  | variant                                | max error      | selected for VC4CL_MATH_ACCURACY
+ * ----------+----------------------------------------+----------------+---------------------------------
+ * exp       | extended precision (default)           | 1 ULP          | -
+ *           | single precision (vc4cl_exp_fast)      | 1 ULP          | >= 1
+ *           | SFU (native_exp)                       | 8192 ULP       | >= 8192
+ * log       | extended precision (default)           | 1 ULP          | -
+ *           | single precision (vc4cl_log_fast)      | 1 ULP          | >= 1
+ *           | SFU (native_log)                       | 8192 ULP       | >= 8192
+ * sin, cos  | extended precision reduction (default) | 2 ULP          | -
+ *           | single precision (half_sin, half_cos)  | 212/1813 ULP   | >= 8192 (extended reduction for |x| > 2^16)
+ * pow, powr | extended precision (default)           | 1 ULP          | -
+ *           | single precision exp(y * log(x))       | 144 ULP        | >= 144
+ *
+ * The single precision exp and log are less accurate than the extended precision variants (0.96 and 0.81 instead of
+ * 0.63 and 0.58 ULP measured), but still stay within 1 ULP. The trigonometric functions have no
+ * intermediate variant, since dropping the lower part of the extended precision argument reduction saves little and
+ * loses the bound for arguments close to multiples of pi/2.
+ *
+ * In relaxed math mode (see above), all functions use their fastest variant. Only there, sin and cos use the half
+ * versions for all arguments, since relaxed math only bounds their error for |x| <= pi.
+ */
+#ifdef VC4CL_RELAXED_MATH
+#define VC4CL_ALLOWS_ULP(ulp) 1
+#elif defined(VC4CL_MATH_ACCURACY)
+#define VC4CL_ALLOWS_ULP(ulp) (VC4CL_MATH_ACCURACY >= (ulp))
+#else
+#define VC4CL_ALLOWS_ULP(ulp) 0
+#endif
+
 #endif /* VC4CL_CONFIG_H */
 
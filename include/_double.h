@@ -0,0 +1,143 @@
+/*
+ * Author: doe300
+ *
+ * See the file "LICENSE" for the full license governing this code.
+ */
+
+#ifndef VC4CL_DOUBLE_H
+#define VC4CL_DOUBLE_H
+
+#include "_config.h"
+#include "_overloads.h"
+#include "_float_float.h"
+
+/*
+ * Emulated double precision
+ *
+ * The hardware has no support for double precision and the compiler does not lower the double type, so cl_khr_fp64 is
+ * not supported (see defines.h). Instead, the vc4cl_double type stores a FloatFloat value (see _float_float.h) and all
+ * operations on it are explicit function calls, e.g. vc4cl_double_add(a, vc4cl_double_mul(b, c)) instead of a + b * c.
+ * Values are created with vc4cl_convert_double and rounded back to single precision with vc4cl_convert_float.
+ *
+ * Compared to IEEE 754 double precision, the emulated type has:
+ * - a precision of ~48 instead of 53 bits, the basic operations are not correctly rounded (relative error ~2^-46)
+ * - the exponent range of float: values above FLT_MAX overflow to Inf and values below FLT_MIN are flushed to zero.
+ *   Below ~2^-100 the lower part becomes subnormal (and is flushed), so the precision degrades to single precision.
+ * - special values (Inf, NaN) only in the upper part, which are not handled by the arithmetic functions
+ * - a different bit representation: the upper float is stored in the lower and the lower float in the upper 32 bits of
+ *   the underlying ulong, so buffers copied from/to the host do not contain IEEE 754 doubles
+ */
+typedef FloatFloat vc4cl_double;
+typedef FloatFloat2 vc4cl_double2;
+typedef FloatFloat3 vc4cl_double3;
+typedef FloatFloat4 vc4cl_double4;
+typedef FloatFloat8 vc4cl_double8;
+typedef FloatFloat16 vc4cl_double16;
+
+/*
+ * Arithmetic operations
+ */
+SIMPLE_2(vc4cl_double, vc4cl_double_add, vc4cl_double, a, vc4cl_double, b, vc4cl_add(a, b))
+SIMPLE_2(vc4cl_double, vc4cl_double_sub, vc4cl_double, a, vc4cl_double, b, vc4cl_sub(a, b))
+SIMPLE_2(vc4cl_double, vc4cl_double_mul, vc4cl_double, a, vc4cl_double, b, vc4cl_mul(a, b))
+SIMPLE_2(vc4cl_double, vc4cl_double_div, vc4cl_double, a, vc4cl_double, b, vc4cl_div(a, b))
+SIMPLE_1(vc4cl_double, vc4cl_double_neg, vc4cl_double, val, vc4cl_combine(-vc4cl_upper(val), -vc4cl_lower(val)))
+
+/*
+ * Comparisons. The scalar versions return 1 and the vector versions -1 (all bits set) for true.
+ */
+SIMPLE_2(int, vc4cl_double_isequal, vc4cl_double, a, vc4cl_double, b, vc4cl_isequal(a, b))
+SIMPLE_2(int, vc4cl_double_isnotequal, vc4cl_double, a, vc4cl_double, b, vc4cl_isnotequal(a, b))
+SIMPLE_2(int, vc4cl_double_isless, vc4cl_double, a, vc4cl_double, b, vc4cl_isless(a, b))
+SIMPLE_2(int, vc4cl_double_islessequal, vc4cl_double, a, vc4cl_double, b, vc4cl_islessequal(a, b))
+SIMPLE_2(int, vc4cl_double_isgreater, vc4cl_double, a, vc4cl_double, b, vc4cl_isgreater(a, b))
+SIMPLE_2(int, vc4cl_double_isgreaterequal, vc4cl_double, a, vc4cl_double, b, vc4cl_isgreaterequal(a, b))
+
+/*
+ * Rounds the emulated double to single precision.
+ *
+ * The upper part already is the value rounded to nearest. For the other rounding modes, it is moved to the neighboring
+ * float, if it was rounded in the wrong direction, as indicated by the sign of the lower part.
+ */
+SIMPLE_1(float, vc4cl_convert_float, vc4cl_double, val, vc4cl_upper(val))
+SIMPLE_1(float, vc4cl_convert_float_rte, vc4cl_double, val, vc4cl_upper(val))
+COMPLEX_1(float, vc4cl_convert_float_rtz, vc4cl_double, val, {
+	int_t bits = vc4cl_bitcast_int(vc4cl_upper(val));
+	int_t lowerBits = vc4cl_bitcast_int(vc4cl_lower(val));
+	// rounded away from zero, if the lower part is not zero and has the other sign
+	int_t roundedUp = (lowerBits & 0x7FFFFFFF) != 0 && (bits ^ lowerBits) < 0;
+	return vc4cl_bitcast_float(roundedUp ? bits - 1 : bits);
+})
+COMPLEX_1(float, vc4cl_convert_float_rtp, vc4cl_double, val, {
+	int_t bits = vc4cl_bitcast_int(vc4cl_upper(val));
+	// rounded down, if the lower part is positive. Since floats are stored as sign and magnitude, the next larger value
+	// is the next integer for positive and the previous integer for negative values
+	return vc4cl_bitcast_float(vc4cl_lower(val) > 0.0f ? (bits >= 0 ? bits + 1 : bits - 1) : bits);
+})
+COMPLEX_1(float, vc4cl_convert_float_rtn, vc4cl_double, val, {
+	int_t bits = vc4cl_bitcast_int(vc4cl_upper(val));
+	// rounded up, if the lower part is negative, see vc4cl_convert_float_rtp
+	return vc4cl_bitcast_float(vc4cl_lower(val) < 0.0f ? (bits >= 0 ? bits - 1 : bits + 1) : bits);
+})
+
+/*
+ * Converts to the emulated double. The conversions from float, (u)char, (u)short and (u)int are exact, long values are
+ * rounded to ~48 bits.
+ *
+ * NOTE: There is no conversion from ulong, since ulong is the underlying type of vc4cl_double. Use
+ * vc4cl_ulong_to_float_float instead.
+ */
+SIMPLE_1(vc4cl_double, vc4cl_convert_double, float, val, vc4cl_extend(val))
+// (u)char and (u)short values can be represented exactly as float
+SIMPLE_1(vc4cl_double, vc4cl_convert_double, char, val, vc4cl_extend(vc4cl_itof(vc4cl_extend(val))))
+SIMPLE_1(vc4cl_double, vc4cl_convert_double, uchar, val, vc4cl_extend(vc4cl_itof(vc4cl_bitcast_int(vc4cl_extend(val)))))
+SIMPLE_1(vc4cl_double, vc4cl_convert_double, short, val, vc4cl_extend(vc4cl_itof(vc4cl_extend(val))))
+SIMPLE_1(vc4cl_double, vc4cl_convert_double, ushort, val, vc4cl_extend(vc4cl_itof(vc4cl_bitcast_int(vc4cl_extend(val)))))
+SIMPLE_1(vc4cl_double, vc4cl_convert_double, int, val, vc4cl_int_to_float_float(val))
+// the halves of the unsigned integer have at most 16 significant bits, see vc4cl_int_to_float_float
+SIMPLE_1(vc4cl_double, vc4cl_convert_double, uint, val,
+	vc4cl_add(vc4cl_itof(vc4cl_bitcast_int(val >> 16)) * 65536.0f, vc4cl_itof(vc4cl_bitcast_int(val & 0xFFFF))))
+SIMPLE_1(vc4cl_double, vc4cl_convert_double, long, val, vc4cl_long_to_float_float(val))
+
+// see vc4cl_long_to_float_float
+COMPLEX_1(FloatFloat, vc4cl_ulong_to_float_float, ulong, val, {
+	result_t high = vc4cl_convert_double(vc4cl_long_to_int(val >> 32));
+	return vc4cl_add(vc4cl_scale(high, (float_t) 0x1.0p32f), vc4cl_convert_double(vc4cl_long_to_int(val)));
+})
+
+/*
+ * Math functions commonly used in double precision accumulation
+ */
+SIMPLE_1(vc4cl_double, vc4cl_double_fabs, vc4cl_double, val,
+	vc4cl_combine(fabs(vc4cl_upper(val)), vc4cl_upper(val) < 0.0f ? -vc4cl_lower(val) : vc4cl_lower(val)))
+// the product is not fused, but calculated in extended precision, see vc4cl_mul_add
+SIMPLE_3(vc4cl_double, vc4cl_double_fma, vc4cl_double, a, vc4cl_double, b, vc4cl_double, c, vc4cl_mul_add(a, b, c))
+
+/*
+ * Extended precision square root, exponential and logarithm with the handling of special values (which are stored in
+ * the upper part)
+ */
+COMPLEX_1(vc4cl_double, vc4cl_double_sqrt, vc4cl_double, val, {
+	float_t upper = vc4cl_upper(val);
+	result_t result = vc4cl_sqrt(val);
+	// sqrt(+-0) = +-0, sqrt(Inf) = Inf, sqrt(NaN) = NaN, sqrt(x) = NaN for x < 0
+	int_t isSpecial = upper == 0.0f || upper < 0.0f || isinf(upper) || isnan(upper);
+	float_t special = upper < 0.0f ? (float_t) nan(0) : upper;
+	return vc4cl_combine(isSpecial ? special : vc4cl_upper(result), isSpecial ? (float_t) 0.0f : vc4cl_lower(result));
+})
+COMPLEX_1(vc4cl_double, vc4cl_double_exp, vc4cl_double, val, {
+	float_t upper = vc4cl_upper(val);
+	// +-Inf are handled by the clamping of the argument
+	result_t result = vc4cl_exp(val);
+	return vc4cl_combine(isnan(upper) ? upper : vc4cl_upper(result), isnan(upper) ? (float_t) 0.0f : vc4cl_lower(result));
+})
+COMPLEX_1(vc4cl_double, vc4cl_double_log, vc4cl_double, val, {
+	float_t upper = vc4cl_upper(val);
+	result_t result = vc4cl_log(val);
+	// log(+-0) = -Inf, log(x) = NaN for x < 0, log(Inf) = Inf, log(NaN) = NaN
+	int_t isSpecial = upper <= 0.0f || isinf(upper) || isnan(upper);
+	float_t special = upper == 0.0f ? (float_t) -INFINITY : (upper < 0.0f ? (float_t) nan(0) : upper);
+	return vc4cl_combine(isSpecial ? special : vc4cl_upper(result), isSpecial ? (float_t) 0.0f : vc4cl_lower(result));
+})
+
+#endif /* VC4CL_DOUBLE_H */
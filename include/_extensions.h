@@ -169,5 +169,68 @@ uint arm_dot_acc_sat(uchar4 a, uchar4 b, uint acc) OVERLOADABLE CONST
 	return add_sat(acc, tmp.s0 + tmp.s1 + tmp.s2 + tmp.s3);
 }
 
+/*
+ * Float-float (double-float) arithmetic
+ *
+ * Adds types
+ *  FloatFloat, FloatFloat2, FloatFloat3, FloatFloat4, FloatFloat8, FloatFloat16
+ * which store a value with ~48 bits of precision as the unevaluated sum of two floats (the upper part in the lower 32
+ * bits of the underlying ulong). The value range is the same as for float.
+ *
+ * Adds functions (all with vector versions, vc4cl_sum_compensated and vc4cl_dot_compensated reduce the vector to a
+ * scalar):
+ *  float vc4cl_upper(FloatFloat val), float vc4cl_lower(FloatFloat val), float vc4cl_lossy(FloatFloat val)
+ *  FloatFloat vc4cl_combine(float upper, float lower), FloatFloat vc4cl_extend(float val)
+ *  FloatFloat vc4cl_int_to_float_float(int val), FloatFloat vc4cl_long_to_float_float(long val)
+ *  FloatFloat vc4cl_add(float a, float b), FloatFloat vc4cl_add(FloatFloat a, FloatFloat b)
+ *  FloatFloat vc4cl_sub(FloatFloat a, FloatFloat b)
+ *  FloatFloat vc4cl_mul(float a, float b), FloatFloat vc4cl_mul(FloatFloat a, FloatFloat b)
+ *  FloatFloat vc4cl_mul_add(float a, float b, FloatFloat c), FloatFloat vc4cl_mul_add(FloatFloat a, FloatFloat b,
+ *    FloatFloat c)
+ *  FloatFloat vc4cl_div(FloatFloat a, FloatFloat b), FloatFloat vc4cl_recip(FloatFloat val)
+ *  FloatFloat vc4cl_sqrt(FloatFloat val), FloatFloat vc4cl_exp(FloatFloat val), FloatFloat vc4cl_log(FloatFloat val)
+ *  FloatFloat vc4cl_scale(FloatFloat val, float powerOfTwo)
+ *  float vc4cl_add_rounded(FloatFloat a, float b)
+ *  FloatFloat vc4cl_accumulate(FloatFloat acc, float val)
+ *  FloatFloat vc4cl_sum_compensated(floatN val), FloatFloat vc4cl_sum_compensated(FloatFloatN val)
+ *  FloatFloat vc4cl_dot_compensated(floatN a, floatN b)
+ *  int vc4cl_isequal/vc4cl_isnotequal/vc4cl_isless/vc4cl_islessequal/vc4cl_isgreater/vc4cl_isgreaterequal(
+ *    FloatFloat a, FloatFloat b)
+ * vc4cl_mul(float, float) and vc4cl_add(float, float) are exact, vc4cl_lossy rounds to float and vc4cl_add_rounded
+ * returns the correctly rounded float sum. Special values (Inf, NaN and for vc4cl_log and vc4cl_sqrt non-positive
+ * values) are not handled.
+ *
+ * NOTE: The implementations reside in _float_float.h.
+ */
+#ifndef cl_vc4cl_float_float
+#define cl_vc4cl_float_float 1
+#endif
+
+/*
+ * Emulated double precision
+ *
+ * Adds types
+ *  vc4cl_double, vc4cl_double2, vc4cl_double3, vc4cl_double4, vc4cl_double8, vc4cl_double16
+ * which store FloatFloat values (see cl_vc4cl_float_float). This does not provide cl_khr_fp64: the double type and
+ * double literals are not supported, all operations are explicit function calls.
+ *
+ * Adds functions (all with vector versions):
+ *  vc4cl_double vc4cl_double_add/vc4cl_double_sub/vc4cl_double_mul/vc4cl_double_div(vc4cl_double a, vc4cl_double b)
+ *  vc4cl_double vc4cl_double_neg(vc4cl_double val), vc4cl_double vc4cl_double_fabs(vc4cl_double val)
+ *  vc4cl_double vc4cl_double_fma(vc4cl_double a, vc4cl_double b, vc4cl_double c)
+ *  vc4cl_double vc4cl_double_sqrt/vc4cl_double_exp/vc4cl_double_log(vc4cl_double val)
+ *  int vc4cl_double_isequal/vc4cl_double_isnotequal/vc4cl_double_isless/vc4cl_double_islessequal/
+ *    vc4cl_double_isgreater/vc4cl_double_isgreaterequal(vc4cl_double a, vc4cl_double b)
+ *  float vc4cl_convert_float(vc4cl_double val) (and the _rte, _rtz, _rtp and _rtn versions)
+ *  vc4cl_double vc4cl_convert_double(float/char/uchar/short/ushort/int/uint/long val)
+ * The emulated type has ~48 bits of precision, but only the exponent range of float. Special values are handled by
+ * vc4cl_double_sqrt, vc4cl_double_exp and vc4cl_double_log only.
+ *
+ * NOTE: The implementations reside in _double.h.
+ */
+#ifndef cl_vc4cl_double
+#define cl_vc4cl_double 1
+#endif
+
 #endif /* VC4CL_EXTENSIONS_H */
 
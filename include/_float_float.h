@@ -11,6 +11,9 @@
  *   Computers 7, Jul 2006, Nancy, France. pp.23-32. hal-00021443
  *   https://hal.archives-ouvertes.fr/hal-00021443 (https://hal.archives-ouvertes.fr/hal-00021443/document)
  * - https://andrewthall.org/papers/df64_qf128.pdf
+ *
+ * The type and the functions are also available to kernels as vendor extension, see cl_vc4cl_float_float in
+ * _extensions.h.
  */
 #ifndef VC4CL_FLOAT_FLOAT_H
 #define VC4CL_FLOAT_FLOAT_H
@@ -33,6 +36,33 @@ typedef ulong4 FloatFloat4;
 typedef ulong8 FloatFloat8;
 typedef ulong16 FloatFloat16;
 
+// vc4cl_split(double) of M_LN2
+#define M_LN2_FF 0xB102E3083F317218
+// vc4cl_split(double) of M_PI
+#define M_PI_FF 0xB3BBBD2E40490FDB
+// vc4cl_split(double) of M_PI_2
+#define M_PI_2_FF 0xB33BBD2E3FC90FDB
+// vc4cl_split(double) of M_LOG2E
+#define M_LOG2E_FF 0x32A570603FB8AA3B
+// vc4cl_split(double) of log2(10)
+#define M_LOG2_10_FF 0x33979A3740549A78
+// vc4cl_split(double) of log10(2)
+#define M_LOG10_2_FF 0xB27608603E9A209B
+// vc4cl_split(double) of log2(pi)
+#define M_LOG2_PI_FF 0xB33672213FD3643A
+// vc4cl_split(double) of 1/6
+#define M_1_6_FF 0xB1AAAAAB3E2AAAAB
+// vc4cl_split(double) of 1/24
+#define M_1_24_FF 0xB0AAAAAB3D2AAAAB
+
+COMPLEX_1(float, vc4cl_pow2, int, val, {
+	// y = 2^x = 1.0 [implied] * 2^(x + offset)
+	int_t tmp = val << 23;
+	// alternative: tmp = (val + 127) << 23;
+	tmp += (int_t) 0x3F800000;
+	return vc4cl_bitcast_float(tmp & (int_t) 0x7F800000);
+})
+
 SIMPLE_1(float, vc4cl_upper, FloatFloat, val, vc4cl_bitcast_float(vc4cl_long_to_int(val)))
 SIMPLE_1(float, vc4cl_lower, FloatFloat, val, vc4cl_bitcast_float(vc4cl_long_to_int(val >> 32)))
 SIMPLE_1(float, vc4cl_lossy, FloatFloat, val, vc4cl_upper(val) + vc4cl_lower(val))
@@ -46,24 +76,24 @@ COMPLEX_2(FloatFloat, vc4cl_combine, float, upper, float, lower, {
 // faster version of vc4cl_combine(val, 0)
 SIMPLE_1(FloatFloat, vc4cl_extend, float, val, vc4cl_int_to_ulong(vc4cl_bitcast_uint(val)))
 
-// TODO avoid using this, since it runs against Inf, due to calculating val * 2^15
+/*
+ * Splits the value into an upper part with the upper 12 bits of the mantissa and a lower part with the remaining 12
+ * bits, so that the partial products in vc4cl_mul are exact.
+ *
+ * Unlike the Veltkamp splitting (which calculates val * (2^12 + 1)), truncating the mantissa bits can not overflow, so
+ * the product is exact for all finite factors (as long as the error term is not subnormal).
+ */
 COMPLEX_1(FloatFloat, vc4cl_split, float, val, {
-	// 2^s where p/2 <= s <= p - 1 with (p = bits in mantissa = 23)
-	const float split = (float) (1u << 15); // TODO can be modified for precision
-	arg_t c = (split + 1) * val;
-	arg_t high = c - (c - val);
-	arg_t low = val - high;
-	return vc4cl_combine(high, low);
-})
-
-// COMPLEX_1(FloatFloat, vc4cl_split, double, val, {
-// 	// 2^s where p/2 <= s <= p - 1 with (p = bits in mantissa = 23)
-// 	const double split = (double) (1u << 29); // TODO can be modified for precision
-// 	arg_t c = (split + 1) * val;
-// 	arg_t high = c - (c - val);
-// 	arg_t low = val - high;
-// 	return vc4cl_combine(high, low);
-// })
+	arg_t high = vc4cl_bitcast_float(vc4cl_bitcast_uint(val) & 0xFFFFF000);
+	return vc4cl_combine(high, val - high);
+})
+
+/*
+ * Multiplies both parts with the factor, which needs to be a power of two. The result is exact, as long as the lower
+ * part does not become subnormal.
+ */
+SIMPLE_2(FloatFloat, vc4cl_scale, FloatFloat, val, float, factor,
+	vc4cl_combine(vc4cl_upper(val) * factor, vc4cl_lower(val) * factor))
 
 COMPLEX_2(FloatFloat, vc4cl_add, float, a, float, b, {
 	float_t s = a + b;
@@ -82,6 +112,61 @@ COMPLEX_2(FloatFloat, vc4cl_add, FloatFloat, a, FloatFloat, b, {
 
 SIMPLE_2(FloatFloat, vc4cl_sub, FloatFloat, a, FloatFloat, b, vc4cl_add(a, vc4cl_combine(-vc4cl_upper(b), -vc4cl_lower(b))))
 
+/*
+ * Comparisons of extended precision values, which need to be normalized (as returned by all arithmetic functions), i.e.
+ * the lower part is at most half an ULP of the upper part. Like the relational functions, the scalar versions return 1
+ * and the vector versions -1 (all bits set) for true.
+ */
+SIMPLE_2(int, vc4cl_isequal, FloatFloat, a, FloatFloat, b,
+	vc4cl_upper(a) == vc4cl_upper(b) && vc4cl_lower(a) == vc4cl_lower(b))
+SIMPLE_2(int, vc4cl_isnotequal, FloatFloat, a, FloatFloat, b,
+	vc4cl_upper(a) != vc4cl_upper(b) || vc4cl_lower(a) != vc4cl_lower(b))
+SIMPLE_2(int, vc4cl_isless, FloatFloat, a, FloatFloat, b,
+	vc4cl_upper(a) < vc4cl_upper(b) || (vc4cl_upper(a) == vc4cl_upper(b) && vc4cl_lower(a) < vc4cl_lower(b)))
+SIMPLE_2(int, vc4cl_islessequal, FloatFloat, a, FloatFloat, b,
+	vc4cl_upper(a) < vc4cl_upper(b) || (vc4cl_upper(a) == vc4cl_upper(b) && vc4cl_lower(a) <= vc4cl_lower(b)))
+SIMPLE_2(int, vc4cl_isgreater, FloatFloat, a, FloatFloat, b, vc4cl_isless(b, a))
+SIMPLE_2(int, vc4cl_isgreaterequal, FloatFloat, a, FloatFloat, b, vc4cl_islessequal(b, a))
+
+/*
+ * Converts the integer to extended precision. Both halves of the integer have at most 16 significant bits and are
+ * converted exactly, so the result is exact.
+ */
+SIMPLE_1(FloatFloat, vc4cl_int_to_float_float, int, val,
+	vc4cl_add(vc4cl_itof(val & (arg_t) 0xFFFF0000), vc4cl_itof(val & (arg_t) 0xFFFF)))
+
+/*
+ * Converts the long integer to extended precision, which rounds values with more than 48 significant bits.
+ *
+ * The upper (signed) and lower (unsigned) 32 bits are converted separately and the upper part is scaled by 2^32.
+ */
+COMPLEX_1(FloatFloat, vc4cl_long_to_float_float, long, val, {
+	int_t lowBits = vc4cl_long_to_int(val);
+	result_t high = vc4cl_int_to_float_float(vc4cl_long_to_int(val >> 32));
+	result_t low = vc4cl_add(vc4cl_itof((lowBits >> 16) & 0xFFFF) * 65536.0f, vc4cl_itof(lowBits & 0xFFFF));
+	return vc4cl_add(vc4cl_scale(high, (float_t) 0x1.0p32f), low);
+})
+
+/*
+ * Calculates the correctly rounded (to nearest) single precision value of the extended precision value plus the
+ * summand.
+ *
+ * Uses the rounding to odd of the error terms to prevent double rounding, see:
+ * Sylvie Boldo, Guillaume Melquiond. Emulation of FMA and correctly-rounded sums: proved algorithms using rounding to
+ * odd. IEEE Transactions on Computers, 2008, 57 (4), pp.462-471. https://hal.inria.fr/inria-00080427
+ */
+COMPLEX_2(float, vc4cl_add_rounded, FloatFloat, a, float, b, {
+	arg0_t sum = vc4cl_add(b, vc4cl_upper(a));
+	arg0_t tail = vc4cl_add(vc4cl_lower(sum), vc4cl_lower(a));
+	// round the tail to odd: if it is inexact and its LSB is not set, use the neighbor in the direction of the error
+	uint_t bits = vc4cl_bitcast_uint(vc4cl_upper(tail));
+	uint_t error = vc4cl_bitcast_uint(vc4cl_lower(tail));
+	int_t roundToOdd = (error & 0x7FFFFFFF) != 0 && (bits & 1) == 0;
+	int_t towardsZero = ((bits ^ error) & 0x80000000) != 0;
+	bits = roundToOdd ? (towardsZero ? bits - 1 : bits + 1) : bits;
+	return vc4cl_upper(sum) + vc4cl_bitcast_float(bits);
+})
+
 COMPLEX_2(FloatFloat, vc4cl_mul, float, a, float, b, {
 	float_t x = a * b;
 	result_t a_split = vc4cl_split(a);
@@ -99,6 +184,23 @@ COMPLEX_2(FloatFloat, vc4cl_mul, FloatFloat, a, FloatFloat, b, {
 	return vc4cl_add(vc4cl_upper(t), t1);
 })
 
+/*
+ * Calculates a * b + c in extended precision, e.g. to accumulate a sum of products with a single rounding per step.
+ */
+SIMPLE_3(FloatFloat, vc4cl_mul_add, FloatFloat, a, FloatFloat, b, FloatFloat, c, vc4cl_add(vc4cl_mul(a, b), c))
+// the product of single precision factors is exact
+SIMPLE_3(FloatFloat, vc4cl_mul_add, float, a, float, b, FloatFloat, c, vc4cl_add(vc4cl_mul(a, b), c))
+
+/*
+ * Adds a single precision value to the extended precision accumulator, e.g. to sum up long arrays without the loss of
+ * precision of a single precision sum. Cheaper than vc4cl_add(acc, vc4cl_extend(val)), since the addition of the lower
+ * parts is not required.
+ */
+COMPLEX_2(FloatFloat, vc4cl_accumulate, FloatFloat, acc, float, val, {
+	result_t sum = vc4cl_add(vc4cl_upper(acc), val);
+	return vc4cl_add(vc4cl_upper(sum), vc4cl_lower(sum) + vc4cl_lower(acc));
+})
+
 COMPLEX_2(FloatFloat, vc4cl_div, FloatFloat, a, FloatFloat, b, {
 	float_t xn = 1.0f / vc4cl_upper(b);
 	float_t yn = vc4cl_upper(a) * xn;
@@ -114,8 +216,198 @@ COMPLEX_1(FloatFloat, vc4cl_sqrt, FloatFloat, a, {
 	result_t y = vc4cl_extend(yn);
 	result_t ynsqr = vc4cl_mul(y, y); // yn^2
 	float_t diff = vc4cl_upper(vc4cl_sub(a, ynsqr));
-	result_t prod = vc4cl_mul(xn, diff) / 2;
+	result_t prod = vc4cl_mul(xn * 0.5f, diff);
 	return vc4cl_add(y, prod);
 })
 
+/*
+ * Calculates 1 / x in extended precision with a single Newton iteration on the single precision reciprocal, see
+ * vc4cl_div.
+ */
+COMPLEX_1(FloatFloat, vc4cl_recip, FloatFloat, val, {
+	float_t xn = 1.0f / vc4cl_upper(val);
+	float_t diff = vc4cl_upper(vc4cl_sub(vc4cl_extend((float_t) 1.0f), vc4cl_mul(val, vc4cl_extend(xn))));
+	return vc4cl_add(vc4cl_extend(xn), vc4cl_mul(xn, diff));
+})
+
+/*
+ * Calculates e^x - 1 in extended precision for |x| <= log(2) / 2, see vc4cl_exp and vc4cl_log.
+ *
+ * The argument is scaled by 2^-4 and e^s - 1 is approximated with the Taylor polynomial of degree 6 (truncation error
+ * < 2^-51), of which the two highest terms are calculated in single precision. The result is scaled back with four
+ * steps of e^2s - 1 = (e^s - 1) * (e^s - 1) + 2 * (e^s - 1), which keep the relative precision for small results.
+ */
+COMPLEX_1(FloatFloat, vc4cl_expm1_reduced, FloatFloat, val, {
+	result_t s = vc4cl_scale(val, (float_t) 0.0625f);
+	float_t tail = (1.0f / 120.0f) + vc4cl_upper(s) * (1.0f / 720.0f);
+	result_t poly = vc4cl_add(M_1_24_FF, vc4cl_mul(vc4cl_upper(s), tail));
+	poly = vc4cl_add(M_1_6_FF, vc4cl_mul(s, poly));
+	poly = vc4cl_add(vc4cl_extend((float_t) 0.5f), vc4cl_mul(s, poly));
+	result_t result = vc4cl_add(s, vc4cl_mul(vc4cl_mul(s, s), poly));
+	result = vc4cl_add(vc4cl_mul(result, result), vc4cl_scale(result, (float_t) 2.0f));
+	result = vc4cl_add(vc4cl_mul(result, result), vc4cl_scale(result, (float_t) 2.0f));
+	result = vc4cl_add(vc4cl_mul(result, result), vc4cl_scale(result, (float_t) 2.0f));
+	return vc4cl_add(vc4cl_mul(result, result), vc4cl_scale(result, (float_t) 2.0f));
+})
+
+/*
+ * Calculates e^x in extended precision.
+ *
+ * Range reduction: x = k * log(2) + r with |r| <= log(2) / 2, where log(2) is split into three parts, of which the
+ * first has only 15 significant bits, so that x - k * part is exact. This gives e^x = 2^k * (1 + (e^r - 1)).
+ *
+ * Max relative error (tested on host, for results >= 2^-100): 2^-46
+ *
+ * NOTE: NaN arguments are not handled and need to be checked by the caller!
+ */
+COMPLEX_1(FloatFloat, vc4cl_exp, FloatFloat, val, {
+	// values outside of this range overflow (to Inf or zero) anyway, the lower part of clamped values is dropped
+	float_t upper = clamp(vc4cl_upper(val), (float_t) -104.0f, (float_t) 89.0f);
+	float_t lower = upper == vc4cl_upper(val) ? vc4cl_lower(val) : (float_t) 0.0f;
+	float_t k = rint(upper * M_LOG2E_F);
+	result_t reduced = vc4cl_add(upper - k * 0x1.62e4p-1f, lower);
+	reduced = vc4cl_sub(reduced, vc4cl_mul(k, (float_t) 0x1.7f7d1cp-20f));
+	reduced = vc4cl_add(reduced, vc4cl_extend(k * -0x1.ef357ap-45f));
+	result_t result = vc4cl_add(vc4cl_extend((float_t) 1.0f), vc4cl_expm1_reduced(reduced));
+	// scale by 2^k in two steps, since 2^k alone can not be represented for all k
+	int_t m = vc4cl_ftoi(k);
+	return vc4cl_scale(vc4cl_scale(result, vc4cl_pow2(m >> 1)), vc4cl_pow2(m - (m >> 1)));
+})
+
+/*
+ * Calculates log(x) in extended precision.
+ *
+ * Range reduction: x = 2^k * m with m in [sqrt(2)/2, sqrt(2)). log(m) is approximated in single precision (see
+ * vc4cl_log_fast) and refined with a single Newton iteration y' = y + m * e^-y - 1, which is calculated as
+ * y + (f + q + f * q) with f = m - 1 and q = e^-y - 1 to keep the relative precision for m close to 1.
+ *
+ * Max relative error (tested on host, for x >= 2^-100): 2^-44
+ *
+ * NOTE: Special values (zero, negative values, Inf and NaN) are not handled and need to be checked by the caller!
+ */
+COMPLEX_1(FloatFloat, vc4cl_log, FloatFloat, val, {
+	int_t bits = vc4cl_bitcast_int(vc4cl_upper(val));
+	int_t exponent = ((bits >> 23) & 0xFF) - 127;
+	int_t k = (bits & 0x007FFFFF) > (int_t) 0x003504F3 ? exponent + 1 : exponent;
+	// scale by 2^-k in two steps, since 2^-k alone can not be represented for all k
+	result_t reduced = vc4cl_scale(vc4cl_scale(val, vc4cl_pow2((-k) >> 1)), vc4cl_pow2(-k - ((-k) >> 1)));
+	result_t f = vc4cl_sub(reduced, vc4cl_extend((float_t) 1.0f));
+	float_t upper = vc4cl_upper(f);
+	float_t s = upper / (2.0f + upper);
+	float_t z = s * s;
+	float_t w = z * z;
+	float_t r = z * (6.6666662693e-01f + w * 2.8498786688e-01f) + w * (4.0000972152e-01f + w * 2.4279078841e-01f);
+	float_t halfSquare = 0.5f * upper * upper;
+	float_t estimate = upper - (halfSquare - s * (halfSquare + r));
+	result_t q = vc4cl_expm1_reduced(vc4cl_extend(-estimate));
+	result_t correction = vc4cl_add(vc4cl_add(f, q), vc4cl_mul(f, q));
+	return vc4cl_add(vc4cl_mul(vc4cl_extend(vc4cl_itof(k)), M_LN2_FF), vc4cl_add(vc4cl_extend(estimate), correction));
+})
+
+/*
+ * Sums up all elements of the vector in extended precision.
+ *
+ * The halves of the vector are added lane-wise until a single value remains. For single precision elements, the first
+ * step is exact. To reduce long arrays, accumulate the values lane-wise in a FloatFloatN with vc4cl_accumulate or
+ * vc4cl_mul_add and sum up the lanes of the accumulator afterwards, e.g.:
+ *
+ *  FloatFloat16 acc = 0;
+ *  for(uint i = 0; i < count; ++i)
+ *    acc = vc4cl_accumulate(acc, vload16(i, in));
+ *  float sum = vc4cl_lossy(vc4cl_sum_compensated(acc));
+ */
+INLINE FloatFloat vc4cl_sum_compensated(FloatFloat val) OVERLOADABLE CONST
+{
+	return val;
+}
+
+INLINE FloatFloat vc4cl_sum_compensated(FloatFloat2 val) OVERLOADABLE CONST
+{
+	return vc4cl_add(val.x, val.y);
+}
+
+INLINE FloatFloat vc4cl_sum_compensated(FloatFloat3 val) OVERLOADABLE CONST
+{
+	return vc4cl_add(vc4cl_add(val.x, val.y), val.z);
+}
+
+INLINE FloatFloat vc4cl_sum_compensated(FloatFloat4 val) OVERLOADABLE CONST
+{
+	return vc4cl_sum_compensated(vc4cl_add(val.xy, val.zw));
+}
+
+INLINE FloatFloat vc4cl_sum_compensated(FloatFloat8 val) OVERLOADABLE CONST
+{
+	return vc4cl_sum_compensated(vc4cl_add(val.lo, val.hi));
+}
+
+INLINE FloatFloat vc4cl_sum_compensated(FloatFloat16 val) OVERLOADABLE CONST
+{
+	return vc4cl_sum_compensated(vc4cl_add(val.lo, val.hi));
+}
+
+INLINE FloatFloat vc4cl_sum_compensated(float val) OVERLOADABLE CONST
+{
+	return vc4cl_extend(val);
+}
+
+INLINE FloatFloat vc4cl_sum_compensated(float2 val) OVERLOADABLE CONST
+{
+	return vc4cl_add(val.x, val.y);
+}
+
+INLINE FloatFloat vc4cl_sum_compensated(float3 val) OVERLOADABLE CONST
+{
+	return vc4cl_accumulate(vc4cl_add(val.x, val.y), val.z);
+}
+
+INLINE FloatFloat vc4cl_sum_compensated(float4 val) OVERLOADABLE CONST
+{
+	return vc4cl_sum_compensated(vc4cl_add(val.xy, val.zw));
+}
+
+INLINE FloatFloat vc4cl_sum_compensated(float8 val) OVERLOADABLE CONST
+{
+	return vc4cl_sum_compensated(vc4cl_add(val.lo, val.hi));
+}
+
+INLINE FloatFloat vc4cl_sum_compensated(float16 val) OVERLOADABLE CONST
+{
+	return vc4cl_sum_compensated(vc4cl_add(val.lo, val.hi));
+}
+
+/*
+ * Calculates the dot product in extended precision. The products are calculated exactly and summed up with
+ * vc4cl_sum_compensated.
+ */
+INLINE FloatFloat vc4cl_dot_compensated(float a, float b) OVERLOADABLE CONST
+{
+	return vc4cl_mul(a, b);
+}
+
+INLINE FloatFloat vc4cl_dot_compensated(float2 a, float2 b) OVERLOADABLE CONST
+{
+	return vc4cl_sum_compensated(vc4cl_mul(a, b));
+}
+
+INLINE FloatFloat vc4cl_dot_compensated(float3 a, float3 b) OVERLOADABLE CONST
+{
+	return vc4cl_sum_compensated(vc4cl_mul(a, b));
+}
+
+INLINE FloatFloat vc4cl_dot_compensated(float4 a, float4 b) OVERLOADABLE CONST
+{
+	return vc4cl_sum_compensated(vc4cl_mul(a, b));
+}
+
+INLINE FloatFloat vc4cl_dot_compensated(float8 a, float8 b) OVERLOADABLE CONST
+{
+	return vc4cl_sum_compensated(vc4cl_mul(a, b));
+}
+
+INLINE FloatFloat vc4cl_dot_compensated(float16 a, float16 b) OVERLOADABLE CONST
+{
+	return vc4cl_sum_compensated(vc4cl_mul(a, b));
+}
+
 #endif /* VC4CL_FLOAT_FLOAT_H */
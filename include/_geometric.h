@@ -51,22 +51,57 @@ INLINE float dot(float4 p0, float4 p1) OVERLOADABLE CONST
 	return tmp.x + tmp.y + tmp.z + tmp.w;
 }
 
-float dot(float8 p0, float8 p1) OVERLOADABLE CONST;
-float dot(float16 p0, float16 p1) OVERLOADABLE CONST;
+// the products are summed up with rotations instead of extracting all elements, see vc4cl_reduce_add
+INLINE float dot(float8 p0, float8 p1) OVERLOADABLE CONST
+{
+	return vc4cl_reduce_add(p0 * p1);
+}
 
-COMPLEX_1_RETURN_SCALAR(float, length, float, p, {
-	float tmp = dot(p, p);
+INLINE float dot(float16 p0, float16 p1) OVERLOADABLE CONST
+{
+	return vc4cl_reduce_add(p0 * p1);
+}
+
+/*
+ * Returns the largest absolute value of all elements, see length
+ */
+INLINE float vc4cl_max_magnitude(float p) OVERLOADABLE CONST
+{
+	return vc4cl_fmaxabs(p, 0.0f);
+}
+
+INLINE float vc4cl_max_magnitude(float2 p) OVERLOADABLE CONST
+{
+	return vc4cl_fmaxabs(p.x, p.y);
+}
 
-	// To mitigate overflow errors for edge-cases, reduce large/increase small numbers, this is taken from LLVM libclc
+INLINE float vc4cl_max_magnitude(float3 p) OVERLOADABLE CONST
+{
+	return vc4cl_fmaxabs(vc4cl_fmaxabs(p.x, p.y), p.z);
+}
+
+INLINE float vc4cl_max_magnitude(float4 p) OVERLOADABLE CONST
+{
+	return vc4cl_max_magnitude(vc4cl_fmaxabs(p.xy, p.zw));
+}
+
+INLINE float vc4cl_max_magnitude(float8 p) OVERLOADABLE CONST
+{
+	return vc4cl_max_magnitude(vc4cl_fmaxabs(p.lo, p.hi));
+}
+
+INLINE float vc4cl_max_magnitude(float16 p) OVERLOADABLE CONST
+{
+	return vc4cl_max_magnitude(vc4cl_fmaxabs(p.lo, p.hi));
+}
+
+COMPLEX_1_RETURN_SCALAR(float, length, float, p, {
+	// To mitigate overflow errors for edge-cases, scale all elements by the exponent of the largest magnitude.
 	// E.g. since dot(x, x) calculates element-wise x^2, every exponent >= 64 goes to Infinity and every exponent <= -64 to zero!
-	float inputFactor = 1.0f;
-	float outputFactor = 1.0f;
-	outputFactor = tmp == INFINITY ? 0x1.0p+65f : outputFactor;
-	inputFactor = tmp == INFINITY ? 0x1.0p-65f : inputFactor;
-	outputFactor = vc4cl_is_zero(tmp) ? 0x1.0p-86f : outputFactor;
-	inputFactor = vc4cl_is_zero(tmp) ? 0x1.0p+86f : inputFactor;
-
-	return sqrt(dot(p * inputFactor, p * inputFactor)) * outputFactor;
+	// Contrary to LLVM libclc, this does not require a second dot product to check for overflow.
+	int exponent = vc4cl_square_scale_exponent(vc4cl_max_magnitude(p));
+	arg_t scaled = p * vc4cl_pow2(-exponent);
+	return sqrt(dot(scaled, scaled)) * vc4cl_pow2(exponent);
 })
 
 //"Returns the distance between p0 and p1.
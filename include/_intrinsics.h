@@ -424,6 +424,128 @@ OVERLOAD_2_SCALAR(ulong, vc4cl_vector_rotate, ulong, val, char, offset)
 OVERLOAD_2_SCALAR(long, vc4cl_vector_rotate, long, val, char, offset)
 OVERLOAD_2_SCALAR(float, vc4cl_vector_rotate, float, val, char, offset)
 
+/*
+ * Horizontal reductions, combine all elements of the vector with the given operation
+ *
+ * Instead of extracting all elements, the vector is combined with its rotations by 1, 2, 4 and 8 elements (butterfly
+ * steps), so that after log2(N) steps the first element contains the combination of all elements. Since the rotation
+ * always rotates all 16 elements (see vc4cl_vector_rotate), the other elements may contain undefined values for vectors
+ * with less than 16 elements.
+ *
+ * The sum of integer vectors wraps around like the element-wise addition, the floating-point sum is calculated in a
+ * different order than a sequential sum, and may therefore differ in rounding.
+ */
+#ifndef REDUCE_ELEMENTS
+#define REDUCE_ELEMENTS(func, type, reduce) \
+	INLINE FUNC_1(type, func, type##16, val) CONST \
+	{ \
+		/* (s0 op s1, s1 op s2, s2 op s3, ..., se op sf, sf op s0) */ \
+		type##16 tmp = reduce(val, vc4cl_vector_rotate(val, -1)); \
+		/* (s0 op s1 op s2 op s3, ...) */ \
+		tmp = reduce(tmp, vc4cl_vector_rotate(tmp, -2)); \
+		/* (s0 op ... op s7, ..., s8 op ... op sf, ...) */ \
+		tmp = reduce(tmp, vc4cl_vector_rotate(tmp, -4)); \
+		/* s0 op s1 op s2 op s3 op s4 op s5 op s6 op s7 op s8 op s9 op sa op sb op sc op sd op se op sf */ \
+		return reduce(tmp, vc4cl_vector_rotate(tmp, -8)).x; \
+	} \
+	INLINE FUNC_1(type, func, type##8, val) CONST \
+	{ \
+		/* (s0 op s1, s1 op s2, ..., s6 op s7, s7 op ?) */ \
+		type##8 tmp = reduce(val, vc4cl_vector_rotate(val, -1)); \
+		/* (s0 op s1 op s2 op s3, ..., s4 op s5 op s6 op s7, ...) */ \
+		tmp = reduce(tmp, vc4cl_vector_rotate(tmp, -2)); \
+		/* s0 op s1 op s2 op s3 op s4 op s5 op s6 op s7 */ \
+		return reduce(tmp, vc4cl_vector_rotate(tmp, -4)).x; \
+	} \
+	INLINE FUNC_1(type, func, type##4, val) CONST \
+	{ \
+		/* (x op y, y op z, z op w, w op ?) */ \
+		type##4 tmp = reduce(val, vc4cl_vector_rotate(val, -1)); \
+		/* x op y op z op w */ \
+		return reduce(tmp, vc4cl_vector_rotate(tmp, -2)).x; \
+	} \
+	INLINE FUNC_1(type, func, type##3, val) CONST \
+	{ \
+		return reduce(reduce(val.x, val.y), val.z); \
+	} \
+	INLINE FUNC_1(type, func, type##2, val) CONST \
+	{ \
+		return reduce(val.x, val.y); \
+	} \
+	INLINE FUNC_1(type, func, type, val) CONST \
+	{ \
+		return val; \
+	}
+#endif
+
+#define REDUCE_ADD(a, b) ((a) + (b))
+#define REDUCE_AND(a, b) ((a) & (b))
+#define REDUCE_OR(a, b) ((a) | (b))
+#define REDUCE_XOR(a, b) ((a) ^ (b))
+
+REDUCE_ELEMENTS(vc4cl_reduce_add, uchar, REDUCE_ADD)
+REDUCE_ELEMENTS(vc4cl_reduce_add, char, REDUCE_ADD)
+REDUCE_ELEMENTS(vc4cl_reduce_add, ushort, REDUCE_ADD)
+REDUCE_ELEMENTS(vc4cl_reduce_add, short, REDUCE_ADD)
+REDUCE_ELEMENTS(vc4cl_reduce_add, uint, REDUCE_ADD)
+REDUCE_ELEMENTS(vc4cl_reduce_add, int, REDUCE_ADD)
+REDUCE_ELEMENTS(vc4cl_reduce_add, ulong, REDUCE_ADD)
+REDUCE_ELEMENTS(vc4cl_reduce_add, long, REDUCE_ADD)
+REDUCE_ELEMENTS(vc4cl_reduce_add, float, REDUCE_ADD)
+
+REDUCE_ELEMENTS(vc4cl_reduce_min, uchar, min)
+REDUCE_ELEMENTS(vc4cl_reduce_min, char, min)
+REDUCE_ELEMENTS(vc4cl_reduce_min, ushort, min)
+REDUCE_ELEMENTS(vc4cl_reduce_min, short, min)
+REDUCE_ELEMENTS(vc4cl_reduce_min, uint, min)
+REDUCE_ELEMENTS(vc4cl_reduce_min, int, min)
+REDUCE_ELEMENTS(vc4cl_reduce_min, ulong, min)
+REDUCE_ELEMENTS(vc4cl_reduce_min, long, min)
+REDUCE_ELEMENTS(vc4cl_reduce_min, float, fmin)
+
+REDUCE_ELEMENTS(vc4cl_reduce_max, uchar, max)
+REDUCE_ELEMENTS(vc4cl_reduce_max, char, max)
+REDUCE_ELEMENTS(vc4cl_reduce_max, ushort, max)
+REDUCE_ELEMENTS(vc4cl_reduce_max, short, max)
+REDUCE_ELEMENTS(vc4cl_reduce_max, uint, max)
+REDUCE_ELEMENTS(vc4cl_reduce_max, int, max)
+REDUCE_ELEMENTS(vc4cl_reduce_max, ulong, max)
+REDUCE_ELEMENTS(vc4cl_reduce_max, long, max)
+REDUCE_ELEMENTS(vc4cl_reduce_max, float, fmax)
+
+REDUCE_ELEMENTS(vc4cl_reduce_and, uchar, REDUCE_AND)
+REDUCE_ELEMENTS(vc4cl_reduce_and, char, REDUCE_AND)
+REDUCE_ELEMENTS(vc4cl_reduce_and, ushort, REDUCE_AND)
+REDUCE_ELEMENTS(vc4cl_reduce_and, short, REDUCE_AND)
+REDUCE_ELEMENTS(vc4cl_reduce_and, uint, REDUCE_AND)
+REDUCE_ELEMENTS(vc4cl_reduce_and, int, REDUCE_AND)
+REDUCE_ELEMENTS(vc4cl_reduce_and, ulong, REDUCE_AND)
+REDUCE_ELEMENTS(vc4cl_reduce_and, long, REDUCE_AND)
+
+REDUCE_ELEMENTS(vc4cl_reduce_or, uchar, REDUCE_OR)
+REDUCE_ELEMENTS(vc4cl_reduce_or, char, REDUCE_OR)
+REDUCE_ELEMENTS(vc4cl_reduce_or, ushort, REDUCE_OR)
+REDUCE_ELEMENTS(vc4cl_reduce_or, short, REDUCE_OR)
+REDUCE_ELEMENTS(vc4cl_reduce_or, uint, REDUCE_OR)
+REDUCE_ELEMENTS(vc4cl_reduce_or, int, REDUCE_OR)
+REDUCE_ELEMENTS(vc4cl_reduce_or, ulong, REDUCE_OR)
+REDUCE_ELEMENTS(vc4cl_reduce_or, long, REDUCE_OR)
+
+REDUCE_ELEMENTS(vc4cl_reduce_xor, uchar, REDUCE_XOR)
+REDUCE_ELEMENTS(vc4cl_reduce_xor, char, REDUCE_XOR)
+REDUCE_ELEMENTS(vc4cl_reduce_xor, ushort, REDUCE_XOR)
+REDUCE_ELEMENTS(vc4cl_reduce_xor, short, REDUCE_XOR)
+REDUCE_ELEMENTS(vc4cl_reduce_xor, uint, REDUCE_XOR)
+REDUCE_ELEMENTS(vc4cl_reduce_xor, int, REDUCE_XOR)
+REDUCE_ELEMENTS(vc4cl_reduce_xor, ulong, REDUCE_XOR)
+REDUCE_ELEMENTS(vc4cl_reduce_xor, long, REDUCE_XOR)
+
+#undef REDUCE_ELEMENTS
+#undef REDUCE_ADD
+#undef REDUCE_AND
+#undef REDUCE_OR
+#undef REDUCE_XOR
+
 /*
  * For debugging purposes
  */
@@ -12,8 +12,6 @@
 #include "_float_float.h"
 
 // TODO test-cases for all the known Edge Case Behavior
-// TODO can remove nan-check from rounding functions? The large value check should also contain NaNs,
-// since VC4 considers NaNs to be the "largest" values
 // TODO recheck NaN handling for functions based on multiplication/division once they handle NaNs correctly,
 // maybe we can remove some of those extra codes
 
@@ -57,36 +55,52 @@
 #undef native_sqrt // via SFU RECIP and SFU RSQRT
 #undef native_tan
 
-// vc4cl_split(double) of M_LN2
-#define M_LN2_FF 0xB102E3083F317218
-// 1 / log10(e)
-#define M_1_LOG10_E_F 2.30258512496948242188f
+/*
+ * Checks for NaN and Inf arguments, which are skipped in relaxed math mode (see VC4CL_RELAXED_MATH), where these values
+ * are undefined.
+ *
+ * NOTE: Checks for NaN and Inf intermediate values (e.g. on overflow of intermediate results) still need to use
+ * isnan/isinf directly!
+ */
+#ifdef VC4CL_RELAXED_MATH
+#define VC4CL_CHECK_NAN(val) 0
+#define VC4CL_CHECK_INF(val) 0
+#define VC4CL_CHECK_INF_NAN(val) 0
+#else
+#define VC4CL_CHECK_NAN(val) isnan(val)
+#define VC4CL_CHECK_INF(val) isinf(val)
+#define VC4CL_CHECK_INF_NAN(val) vc4cl_is_inf_nan(val)
+#endif
 
 INLINE int factorial(int n) CONST
 {
 	return (n == 1 || n == 0) ? 1 : factorial(n - 1) * n;
 }
 
-COMPLEX_3_SCALAR(float, fast_pown, float, val, uint, n, uchar, width, {
-	// reference: http://dimacs.rutgers.edu/archive/Workshops/Security/program2/quisquater/node3.html (method I)
-	result_t result = 1.0f;
-	result_t tmp = val;
-	for(uchar i = 0; i < width; ++i)
-	{
-		// if n[i] == 1 then z = z * y
-		result *= ((n >> i) & 1) ? tmp : 1.0f;
-		// y = y * y
-		tmp = tmp * tmp;
-	}
-	return result;
-})
-
-COMPLEX_1(float, vc4cl_pow2, int, val, {
-	// y = 2^x = 1.0 [implied] * 2^(x + offset)
-	int_t tmp = val << 23;
-	// alternative: tmp = (val + 127) << 23;
-	tmp += (int_t) 0x3F800000;
-	return vc4cl_bitcast_float(tmp & (int_t) 0x7F800000);
+/*
+ * Calculates atan(a / b) for non-negative a and b, used as common kernel for all inverse trigonometric functions.
+ *
+ * The ratio is folded into [0, 1] by dividing the smaller by the larger value and using atan(x) = pi/2 - atan(1/x)
+ * for x > 1. This requires only a single division and also handles infinite a or b. The result is undefined for both
+ * a and b being zero or infinite.
+ *
+ * On [0, 1], atan(r) = r + r * s * P(s) with s = r^2 is approximated by a minimax polynomial P(s) of degree 7 (relative
+ * error of ~2^-25).
+ */
+COMPLEX_2(float, vc4cl_atan_ratio, float, a, float, b, {
+	int_t swap = a > b;
+	result_t ratio = (swap ? b : a) / (swap ? a : b);
+	result_t s = ratio * ratio;
+	result_t p = 0.0029206846f;
+	p = p * s - 0.016367899f;
+	p = p * s + 0.043211814f;
+	p = p * s - 0.075522102f;
+	p = p * s + 0.10666003f;
+	p = p * s - 0.14211056f;
+	p = p * s + 0.19993773f;
+	p = p * s - 0.33333153f;
+	result_t result = ratio + ratio * (s * p);
+	return swap ? (vc4cl_upper(M_PI_2_FF) - result) + vc4cl_lower(M_PI_2_FF) : result;
 })
 
 /**
@@ -96,9 +110,12 @@ COMPLEX_1(float, vc4cl_pow2, int, val, {
  * acos(x) = NaN for |x| > 1
  */
 COMPLEX_1(float, acos, float, val, {
-	result_t result = M_PI_2_F - asin(val);
-	result = fabs(val) > (result_t)1.0f ? nan(0) : result;
-	return isnan(val) ? val : result;
+	// acos(x) = atan2(sqrt(1 - x^2), x), where (1 - |x|) is exact for |x| >= 0.5
+	arg_t absVal = fabs(val);
+	result_t result = vc4cl_atan_ratio(sqrt((1.0f - absVal) * (1.0f + absVal)), absVal);
+	result = val < 0.0f ? (vc4cl_upper(M_PI_FF) - result) + vc4cl_lower(M_PI_FF) : result;
+	result = absVal > (result_t)1.0f ? nan(0) : result;
+	return VC4CL_CHECK_NAN(val) ? val : result;
 })
 
 /**
@@ -108,10 +125,16 @@ COMPLEX_1(float, acos, float, val, {
  * acosh(x) = NaN for x < 1
  * acosh(+Inf) = +Inf
  */
-// https://en.wikipedia.org/wiki/Inverse_hyperbolic_functions#Series_expansions
-// or: https://en.wikipedia.org/wiki/Hyperbolic_function#Inverse_functions_as_logarithms
-// XXX optimize?!
-SIMPLE_1(float, acosh, float, val, log(val + sqrt(val * val + 1)))
+COMPLEX_1(float, acosh, float, val, {
+	// acosh(x) = log(x + sqrt(x^2 - 1)) = log1p(t + sqrt(2t + t^2)) with t = x - 1 (exact), which keeps the precision for
+	// x close to 1. For x >= 2^12, acosh(x) = log(2x) in single precision, which also does not overflow for large x.
+	// Max error (tested on host): 3 ULP
+	arg_t t = val - 1.0f;
+	result_t result = log1p(t + sqrt(2.0f * t + t * t));
+	result = val >= (arg_t) 4096.0f ? log(val) + M_LN2_F : result;
+	result = val < (arg_t) 1.0f ? nan(0) : result;
+	return VC4CL_CHECK_NAN(val) ? val : result;
+})
 
 /**
  * Expected behavior:
@@ -122,7 +145,7 @@ SIMPLE_1(float, acosh, float, val, log(val + sqrt(val * val + 1)))
 COMPLEX_1(float, acospi, float, val, {
 	result_t result = acos(val) * M_1_PI_F;
 	result = fabs(val) > (result_t)1.0f ? nan(0) : result;
-	return isnan(val) ? val : result;
+	return VC4CL_CHECK_NAN(val) ? val : result;
 })
 
 /**
@@ -132,9 +155,11 @@ COMPLEX_1(float, acospi, float, val, {
  * asin(x) = NaN for |x| > 1
  */
 COMPLEX_1(float, asin, float, val, {
-	result_t result = atan(val *rsqrt(1 - val * val));
-	result = fabs(val) > (result_t)1.0f ? nan(0) : result;
-	return isnan(val) ? val : result;
+	// asin(x) = atan2(x, sqrt(1 - x^2)), where (1 - |x|) is exact for |x| >= 0.5
+	arg_t absVal = fabs(val);
+	result_t result = copysign(vc4cl_atan_ratio(absVal, sqrt((1.0f - absVal) * (1.0f + absVal))), val);
+	result = absVal > (result_t)1.0f ? nan(0) : result;
+	return VC4CL_CHECK_NAN(val) ? val : result;
 })
 
 /**
@@ -143,8 +168,17 @@ COMPLEX_1(float, asin, float, val, {
  * asinh(+-0) = +-0
  * asinh(+-Inf) = +-Inf
  */
-// XXX optimize?!
-SIMPLE_1(float, asinh, float, val, log(val + sqrt(val * val - 1)))
+COMPLEX_1(float, asinh, float, val, {
+	// asinh(x) = log(x + sqrt(x^2 + 1)) = log1p(x + x^2 / (1 + sqrt(1 + x^2))) without cancellation for small x. For
+	// |x| >= 2^12, asinh(x) = log(2|x|) in single precision, which also does not overflow for large x.
+	// Max error (tested on host): 2 ULP
+	arg_t absVal = fabs(val);
+	arg_t x2 = absVal * absVal;
+	result_t result = log1p(absVal + x2 / (1.0f + sqrt(1.0f + x2)));
+	result = absVal >= (arg_t) 4096.0f ? log(absVal) + M_LN2_F : result;
+	result = vc4cl_bitcast_float(vc4cl_bitcast_uint(result) | (vc4cl_bitcast_uint(val) & 0x80000000));
+	return VC4CL_CHECK_NAN(val) ? val : result;
+})
 
 /**
  * Expected behavior:
@@ -155,49 +189,19 @@ SIMPLE_1(float, asinh, float, val, log(val + sqrt(val * val - 1)))
 COMPLEX_1(float, asinpi, float, val, {
 	result_t result = asin(val) * M_1_PI_F;
 	result = fabs(val) > (result_t)1.0f ? nan(0) : result;
-	return isnan(val) ? val : result;
+	return VC4CL_CHECK_NAN(val) ? val : result;
 })
 
-// https://stackoverflow.com/questions/23047978/how-is-arctan-implemented
-// https://en.wikipedia.org/wiki/Taylor_series#Approximation_and_convergence (too inaccurate!)
-// http://www2.mae.ufl.edu/~uhk/ARCTAN-APPROX-PAPER.pdf (atan(x) = 1/x * F(1/x))
-// http://www.jjj.de/fxt/fxtbook.pdf
 /**
  * Expected behavior:
  *
  * atan(+-0) = +-0
  * atan(+-Inf) = +-pi/2
- *
- * Argument reduction:
- * 1) atan(-x) = -atan(x)
- * 2) atan(1/x) = PI/2 - atan(x), x > 0
- * 3) atan(1/x) = -PI/2 - atan(x), x < 0
- * 4) atan(x) = 2 atan(x / (1 + sqrt(1 + x^2)))
- *
- * Matters Computational (section 32.1.2.3): Pade Approximation (6 steps)
- * Has an error of ~ 0 for |x| <= 1/8 * PI:
- * (1155∙x + 1190∙x^3 + 231∙x^5)/(1155 + 1575∙x^2+525∙x^4+25∙x^6)
- *
- * Alternatively could be calculated via:
- * atan(x) = atan2(x, 1)
  */
 COMPLEX_1(float, atan, float, val, {
-	// reduce arguments a few times (r = r/(1+sqrt(1+r^2)))
-	uint n = 2;
-	result_t r = val;
-	for(uint i = 0; i < n; ++i)
-		r = r / (1 + sqrt(1 + r * r));
-
-	// compute the pade approximation
-	result_t approx = (1155 * r + 1190 * r * r * r + 231 * r * r * r * r * r) /
-		(1155 + 1575 * r * r + 525 * r * r * r * r + 25 * r * r * r * r * r * r);
-
-	// calculate the result (2^n * approx)
-	result_t result = ((result_t)(2 << (n - 1))) * approx;
-	// atan(x) with x >= 2^26 ~ atan(Inf) => pi/2
-	result = (fabs(val) >= (result_t)0x1p+26f) ? copysign(M_PI_2_F, val) : result;
-	// atan(+-NaN) = +-NaN
-	return isnan(val) ? val : result;
+	// Max error (tested on host): 2 ULP
+	// atan(+-NaN) = +-NaN, atan(+-Inf) = +-pi/2 via 1 / Inf = 0
+	return copysign(vc4cl_atan_ratio(fabs(val), (arg_t) 1.0f), val);
 })
 
 /**
@@ -218,22 +222,16 @@ COMPLEX_1(float, atan, float, val, {
  * atan2(+-Inf, +Inf) = +-pi/4
  */
 COMPLEX_2(float, atan2, float, y, float, x, {
-	// note: these calculation work since the condition is either 0 or all bits set
-	result_t tan = atan(y / x);
-	result_t s = sign(y);
-	int_t xG0 = x > 0;
-	int_t xL0 = x < 0;
-	int_t yEq0 = y == 0;
-	// arctan(y / x) if x > 0
-	int_t res0 = xG0 & vc4cl_bitcast_int(tan);
-	// arctan(y / x) + sign(y) * pi if x < 0, y != 0
-	int_t res1 = xL0 & ~yEq0 & vc4cl_bitcast_int(tan + s * M_PI_F);
-	// pi if x < 0, y = 0
-	int_t res2 = xL0 & yEq0 & vc4cl_bitcast_int(M_PI_F);
-	// sign(y) * pi/2 if x = 0, y != 0
-	int_t res3 = (x == 0) & ~yEq0 & vc4cl_bitcast_int(s * M_PI_2_F);
-	// undefined if x = 0, y = 0
-	return vc4cl_bitcast_float(res0 | res1 | res2 | res3);
+	// Max error (tested on host): 2 ULP
+	arg0_t absY = fabs(y);
+	arg1_t absX = fabs(x);
+	// atan(|y| / |x|) in [0, pi/2], the special cases 0 / 0 and Inf / Inf return 0 and pi/4 (to be mirrored below)
+	result_t result = vc4cl_atan_ratio(absY, absX);
+	result = vc4cl_is_zero(absY) && vc4cl_is_zero(absX) ? (result_t) 0.0f : result;
+	result = VC4CL_CHECK_INF(absY) && VC4CL_CHECK_INF(absX) ? (result_t) M_PI_4_F : result;
+	// mirror to [pi/2, pi] for negative x (including -0) and apply the sign of y
+	result = signbit(x) ? (vc4cl_upper(M_PI_FF) - result) + vc4cl_lower(M_PI_FF) : result;
+	return copysign(result, y);
 })
 
 /**
@@ -243,7 +241,16 @@ COMPLEX_2(float, atan2, float, y, float, x, {
  * atanh(+-1) = +-Inf
  * atanh(x) = NaN for |x| > 1
  */
-SIMPLE_1(float, atanh, float, val, ((result_t) 0.5f) * log((1 + val) / (1 - val)))
+COMPLEX_1(float, atanh, float, val, {
+	// atanh(x) = log((1 + x) / (1 - x)) / 2 = log1p(2x + 2x^2 / (1 - x)) / 2 without cancellation for small x
+	// Max error (tested on host): 2 ULP
+	arg_t absVal = fabs(val);
+	result_t result = 0.5f * log1p(2.0f * absVal + 2.0f * absVal * absVal / (1.0f - absVal));
+	result = absVal == (arg_t) 1.0f ? (result_t) INFINITY : result;
+	result = absVal > (arg_t) 1.0f ? nan(0) : result;
+	result = vc4cl_bitcast_float(vc4cl_bitcast_uint(result) | (vc4cl_bitcast_uint(val) & 0x80000000));
+	return VC4CL_CHECK_NAN(val) ? val : result;
+})
 
 /**
  * Expected behavior:
@@ -251,7 +258,7 @@ SIMPLE_1(float, atanh, float, val, ((result_t) 0.5f) * log((1 + val) / (1 - val)
  * atanpi(+-0) = +-0
  * atanpi(+-Inf) = +-0.5
  */
-SIMPLE_1(float, atanpi, float, val, isnan(val) ? val : atan(val) * M_1_PI_F)
+SIMPLE_1(float, atanpi, float, val, VC4CL_CHECK_NAN(val) ? val : atan(val) * M_1_PI_F)
 
 /**
  * Expected behavior:
@@ -268,18 +275,60 @@ SIMPLE_1(float, atanpi, float, val, isnan(val) ? val : atan(val) * M_1_PI_F)
  * atan2pi(+-Inf, -Inf) = +-0.75
  * atan2pi(+-Inf, +Inf) = +-0.25
  */
-SIMPLE_2(float, atan2pi, float, x, float, y, atan2(x, y) * M_1_PI_F)
+SIMPLE_2(float, atan2pi, float, y, float, x, atan2(y, x) * M_1_PI_F)
 
 /**
  * Expected behavior:
  *
  * cbrt(+-0) = +-0
  * cbrt(+-Inf) = +-Inf
+ * cbrt(NaN) = NaN
+ */
+// Splits |val| = 2^(3 * k) * s with s in [1, 8), seeds s^(-1/3) with a quadratic polynomial and refines it with Newton
+// steps which do not require any division.
+// Max error (tested on host): 1 ULP
+COMPLEX_1(float, cbrt, float, val, {
+	int_t bits = vc4cl_bitcast_int(val) & (int_t) 0x7FFFFFFF;
+	int_t exponent = bits >> 23;
+	int_t mantissa = bits & (int_t) 0x007FFFFF;
+	// we need to support subnormals here, since they are only used as input, not output
+	int_t subnormalShift = vc4cl_clz(mantissa) - (32 - 23);
+	mantissa = exponent == 0 ? (mantissa << subnormalShift) & (int_t) 0x007FFFFF : mantissa;
+	exponent = exponent == 0 ? 1 - subnormalShift : exponent;
+	// k = floor((exponent - 127) / 3), the division is calculated as multiplication with 2^16 / 3 on a positive value,
+	// which is exact for all (also normalized subnormal) exponents
+	int_t k = (vc4cl_mul24(exponent + 257, (int_t) 21846, VC4CL_SIGNED) >> 16) - 128;
+	int_t remainder = exponent - 127 - 3 * k;
+	arg_t m = vc4cl_bitcast_float(mantissa | (int_t) 0x3F800000);
+	arg_t s = vc4cl_bitcast_float(mantissa | ((127 + remainder) << 23));
+	// initial approximation of m^(-1/3) in [1, 2) with a relative error of less than 2^-8, adjusted for s = m * 2^remainder
+	arg_t r = 1.3842741251e+00f + m * (-4.7790777683e-01f + m * 9.1611295938e-02f);
+	r = remainder == 1 ? r * 7.9370051622e-01f : r;
+	r = remainder == 2 ? r * 6.2996053696e-01f : r;
+	// Newton step for the reciprocal cube root: r = r + r * (1 - s * r^3) / 3
+	r = r + r * (1.0f - s * r * r * r) * (1.0f / 3.0f);
+	// cbrt(s) = s * s^(-2/3), refined with a Newton step for c^3 - s using r^2 as approximation of 1 / c^2
+	arg_t c = s * r * r;
+	c = c - (c * c * c - s) * (r * r) * (1.0f / 3.0f);
+	result_t result = c * vc4cl_bitcast_float((k + 127) << 23);
+	result = copysign(result, val);
+	return vc4cl_is_zero(val) || VC4CL_CHECK_INF_NAN(val) ? val : result;
+})
+
+/*
+ * Returns the mask of the bits of the fractional part of the floating-point value (given as bits):
+ * - all bits except the sign for |x| < 1
+ * - the lower 23 - e mantissa bits for 1 <= |x| < 2^23 with the exponent e
+ * - no bits for |x| >= 2^23 (including Inf and NaN), since all these values are integral
+ *
+ * This allows all rounding functions to be calculated with bit operations on all vector elements, without any
+ * special handling for large values, Inf or NaN.
  */
-// TODO different algorithm?
-// e.g. http://www.hackersdelight.org/hdcodetxt/acbrt.c.txt (acbrt1 with a few more Newton steps, but requires several
-// floating-point divisions)
-SIMPLE_1(float, cbrt, float, val, pow(val, 1.0f / 3.0f))
+COMPLEX_1(int, vc4cl_fraction_mask, int, bits, {
+	result_t exponent = ((bits >> 23) & 0xFF) - 127;
+	result_t mask = (result_t) 0x007FFFFF >> clamp(exponent, 0, 31);
+	return exponent < 0 ? (result_t) 0x7FFFFFFF : mask;
+})
 
 /**
  * Expected behavior:
@@ -290,21 +339,12 @@ SIMPLE_1(float, cbrt, float, val, pow(val, 1.0f / 3.0f))
  */
 COMPLEX_1(float, ceil, float, val, {
 	//"Round to integer toward + infinity. "
-
-	// https://stackoverflow.com/questions/12279914/implement-ceil-in-c
-	// http://blog.frama-c.com/index.php?post/2013/05/02/nearbyintf1
-	// all floating point values |val| > 2^23 are exact numbers
-	int_t tooBig = isnan(val) || fabs(val) >= 0x1.0p23f;
-	// |val| < 2^23 fits into integer
-	result_t truncated = vc4cl_itof(vc4cl_ftoi(val));
-	// if the truncation is smaller than val (positive numbers), add 1 to round up
-	result_t ceiling = truncated + (truncated < val ? (result_t)1.0f: (result_t)0.0f);
-	// fix for ceil([-0.9, -0.0]) = -0.0
-	result_t result = copysign(ceiling, val);
-	// fix for negative subnormal values
-	result = result < val ? result + (result_t) 1.0f : result;
-	// deciding here which value to return saves us up to two jumps
-	return tooBig ? val : result;
+	int_t bits = vc4cl_bitcast_int(val);
+	int_t mask = vc4cl_fraction_mask(bits);
+	result_t truncated = vc4cl_bitcast_float(bits & ~mask);
+	// positive values with a fractional part are rounded up, the result of truncating negative values is already the
+	// ceiling (including -0 for -1 < x < 0)
+	return (bits & mask) != 0 && bits >= 0 ? truncated + 1.0f : truncated;
 })
 
 //"Returns x with its sign changed to match the sign of y. "
@@ -314,140 +354,265 @@ COMPLEX_1(float, ceil, float, val, {
 SIMPLE_2(float, copysign, float, x, float, y,
 	vc4cl_bitcast_float((vc4cl_bitcast_uint(y) & 0x80000000) | (vc4cl_bitcast_uint(x) & 0x7FFFFFFF)))
 
-COMPLEX_1(float, cos_pade, float, val, {
-	/*
-	 * Pade approximation
-	 * (https://ir.canterbury.ac.nz/bitstream/handle/10092/8886/brookes_thesis.pdf?sequence=1, page 86)
-	 *
-	 * Has a relative error of far less than 2^23 (1 ULP) for [-PI/2, PI/2], then rises fast
-	 *
-	 * Alternative:
-	 * (see alternative for sin_pade)
-	 */
-	arg_t a = 45469.0f * val * val * val * val * val * val * val * val;
-	arg_t b = 7029024.0f * val * val * val * val * val * val;
-	arg_t c = 348731040.0f * val * val * val * val;
-	arg_t d = 5269904640.0f * val * val;
-	arg_t e = 10983772800.0f;
-	arg_t f = 9336.0f * val * val * val * val * val * val;
-	arg_t g = 2064720.0f * val * val * val * val;
-	arg_t h = 221981760.0f * val * val;
-	arg_t up = a - b + c - d + e;
-	arg_t down = f + g + h + e;
-	return up / down;
+/*
+ * Computes the product of the (scaled) argument with a part of 2/pi modulo 4 and adds it to the accumulated sum.
+ *
+ * Since the upper part of 2/pi (times 2^64) only has integer bits, the integral multiples of 4 which are cut off here
+ * have no influence on the quadrant and the reduced argument.
+ */
+COMPLEX_3(FloatFloat, vc4cl_trig_reduce_step, FloatFloat, sum, float, val, float, part, {
+	result_t product = vc4cl_mul(val, part);
+	// all values with an absolute value >= 2^24 are even, so the modulo is exact. Rounding to the nearest multiple of 4
+	// keeps small values (and thus the precision of the lower part) unchanged
+	arg1_t upper = vc4cl_upper(product);
+	upper = upper - 4.0f * rint(upper * 0.25f);
+	arg1_t lower = vc4cl_lower(product);
+	lower = lower - 4.0f * rint(lower * 0.25f);
+	result_t tmp = vc4cl_add(sum, vc4cl_add(upper, lower));
+	// keep the sum in [-2, 2] to not lose any precision in the lower part
+	upper = vc4cl_upper(tmp);
+	return vc4cl_add(upper - 4.0f * rint(upper * 0.25f), vc4cl_lower(tmp));
 })
 
-/**
- * Expected behavior:
+/*
+ * Payne-Hanek style argument reduction for large (positive) values, see vc4cl_trig_reduce.
  *
- * cos(+-0) = 1
- * cos(+-Inf) = NaN for |x| > 1
+ * The value of 2/pi is split into 8 floats (times 2^64) with a total precision of ~190 bits, which is enough to
+ * calculate the reduced argument for the largest float values (2^128, requiring 128 bits of integer part + 24 bits of
+ * mantissa + some guard bits).
+ * The argument is scaled down by 2^-64 to keep the products with the smallest parts representable.
  */
-COMPLEX_1(float, cos, float, val, {
-	/*
-	 * OpenCL 1.2 EMBEDDED PROFILE allows an error of up to 4 ulp
-	 *
-	 * We use argument reduction to bring it into range [-pi/2, pi/2] in which range the Pade approximation is accurate.
-	 */
-	// TODO normalization into [-pi/2, pi/2] is too inaccurate for large values!
-
-	// Since cosine has a period of 2pi, these rewrites do not change the result (rounding error excluded):
-	// bring into range [-2pi, 2pi]
-	arg_t modifiedVal = fmod(val, 2.0f * M_PI_F);
-	// bring into range [-pi, pi]
-	modifiedVal = modifiedVal < -M_PI_F ? modifiedVal + (2.0f * M_PI_F) : modifiedVal;
-	modifiedVal = modifiedVal > M_PI_F ? modifiedVal - (2.0f * M_PI_F) : modifiedVal;
-
-	// We move by half a period, so we must invert the sign of the result
-	// bring into range [-pi/2, pi/2]
-	int_t invertSign = modifiedVal < -M_PI_2_F || modifiedVal > M_PI_2_F;
-	modifiedVal = modifiedVal < -M_PI_2_F ? modifiedVal + M_PI_F : modifiedVal;
-	modifiedVal = modifiedVal > M_PI_2_F ? modifiedVal - M_PI_F : modifiedVal;
-
-	arg_t result = cos_pade(invertSign ? -modifiedVal : modifiedVal);
-	result = invertSign ? -result : result;
-	result = isinf(val) ? copysign(nan(0), val) : result;
-	return isnan(val) ? val : result;
+COMPLEX_2(FloatFloat, vc4cl_trig_reduce_large, float, val, __private int, *quadrant, {
+	float_t scaled = val * 0x1.0p-64f;
+	result_t sum = vc4cl_extend((float_t) 0.0f);
+	sum = vc4cl_trig_reduce_step(sum, scaled, 0x1.45f306p+63f);
+	sum = vc4cl_trig_reduce_step(sum, scaled, 0x1.b93910p+38f);
+	sum = vc4cl_trig_reduce_step(sum, scaled, 0x1.529fc2p+12f);
+	sum = vc4cl_trig_reduce_step(sum, scaled, 0x1.d5f47ep-14f);
+	sum = vc4cl_trig_reduce_step(sum, scaled, -0x1.659120p-39f);
+	sum = vc4cl_trig_reduce_step(sum, scaled, 0x1.b6c52cp-65f);
+	sum = vc4cl_trig_reduce_step(sum, scaled, -0x1.9b0ef2p-90f);
+	sum = vc4cl_trig_reduce_step(sum, scaled, 0x1.041fe6p-116f);
+	// the sum now contains val * 2/pi modulo 4, split it into the integral quadrant and the fractional part in
+	// [-0.5, 0.5]
+	float_t integral = rint(vc4cl_upper(sum));
+	sum = vc4cl_add(vc4cl_upper(sum) - integral, vc4cl_lower(sum));
+	*quadrant = vc4cl_ftoi(integral) & 3;
+	// reduced = fraction * pi/2
+	return vc4cl_mul(sum, M_PI_2_FF);
+})
+
+/*
+ * Reduces the (positive) argument to the range [-pi/4, pi/4], so that val = quadrant * pi/2 + reduced.
+ *
+ * Returns the reduced argument in extended precision and stores the quadrant (modulo 4) in the output parameter.
+ *
+ * For values up to 2^15, an extended Cody-Waite reduction is used: pi/2 is split into parts, of which all but the last
+ * have only 9 significant bits, so that quadrant * part is exact for all quadrants < 2^15.
+ * Since the accuracy of this reduction decreases with the magnitude of the argument, a more expensive multi-precision
+ * reduction is used for larger values, but only if any element of the vector requires it.
+ *
+ * Max error (of the following sine/cosine calculation, tested on host):
+ * - 2 ULP for [0, 2^15]
+ * - 1 ULP for [2^15, FLT_MAX]
+ *
+ * See also:
+ * https://www.csee.umbc.edu/~phatak/645/supl/Ng-ArgReduction.pdf
+ * http://www.netlib.org/fdlibm/k_rem_pio2.c
+ */
+COMPLEX_2(FloatFloat, vc4cl_trig_reduce, float, val, __private int, *quadrant, {
+	float_t k = rint(val * M_2_PI_F);
+	float_t tmp = val - k * 0x1.92p+0f;
+	tmp = tmp - k * 0x1.fbp-12f;
+	tmp = tmp - k * 0x1.51p-22f;
+	tmp = tmp - k * 0x1.0bp-34f;
+	result_t result = vc4cl_add(tmp, -k * 0x1.184698p-44f);
+	int_t quad = vc4cl_ftoi(k);
+	// MSB of the difference is set, if the value (or NaN) is larger than 2^15
+	if(any((int_t) 0x47000000 - vc4cl_bitcast_int(val)))
+	{
+		int_t largeQuadrant;
+		result_t largeResult = vc4cl_trig_reduce_large(val, &largeQuadrant);
+		int_t isLarge = val > 0x1.0p15f;
+		// select the parts separately, since the condition for 64-bit values would need to be 64-bit too
+		result = vc4cl_combine(isLarge ? vc4cl_upper(largeResult) : vc4cl_upper(result),
+			isLarge ? vc4cl_lower(largeResult) : vc4cl_lower(result));
+		quad = isLarge ? largeQuadrant : quad;
+	}
+	*quadrant = quad & 3;
+	return result;
+})
+
+/*
+ * Reduces the (positive) argument of the pi-scaled trigonometric functions, so that val = quadrant * 0.5 + y with
+ * y in [-0.25, 0.25] and returns y * pi in extended precision.
+ *
+ * Since the reduction is exact for all values, the accuracy does not depend on the magnitude of the argument.
+ */
+COMPLEX_2(FloatFloat, vc4cl_trig_reduce_pi, float, val, __private int, *quadrant, {
+	// bring into range [-1, 1] without overflowing for large values, val - 2 * rint(val / 2) is exact
+	float_t tmp = val - 2.0f * rint(val * 0.5f);
+	float_t k = rint(tmp * 2.0f);
+	tmp = tmp - k * 0.5f;
+	*quadrant = vc4cl_ftoi(k) & 3;
+	result_t product = vc4cl_mul(tmp, vc4cl_upper(M_PI_FF));
+	return vc4cl_add(vc4cl_upper(product), vc4cl_lower(product) + tmp * vc4cl_lower(M_PI_FF));
+})
+
+/*
+ * Calculates the sine and cosine of the reduced argument in the range [-pi/4, pi/4]. Returns the sine and stores the
+ * cosine in the output parameter.
+ *
+ * Uses the minimax polynomials of the Cephes library (http://www.netlib.org/cephes/) and applies the lower part of the
+ * reduced argument as correction term:
+ * sin(x + y) ~ sin(x) + y * cos(x) with cos(x) ~ 1 - x^2/2
+ * cos(x + y) ~ cos(x) - y * sin(x) with sin(x) ~ x
+ *
+ * The polynomials are evaluated in Estrin's scheme, so both of them share the powers x^2 and x^4. Any part not used
+ * by the caller is removed by the compiler.
+ */
+COMPLEX_2(float, vc4cl_sincos_reduced, FloatFloat, val, __private float, *cosval, {
+	float_t x = vc4cl_upper(val);
+	float_t y = vc4cl_lower(val);
+	float_t z = x * x;
+	float_t z2 = z * z;
+	float_t halfZ = 0.5f * z;
+	float_t sinPoly = (-1.6666654611e-1f + 8.3321608736e-3f * z - 1.9515295891e-4f * z2) * z * x;
+	float_t cosPoly = (4.166664568298827e-2f - 1.388731625493765e-3f * z + 2.443315711809948e-5f * z2) * z2;
+	*cosval = 1.0f - halfZ + (cosPoly - y * x);
+	return x + (sinPoly + y * (1.0f - halfZ));
+})
+
+/*
+ * Calculates the sine of quadrant * pi/2 + reduced, where the quadrant is read after the reduced argument (and
+ * therefore the quadrant) was calculated.
+ */
+COMPLEX_2(float, vc4cl_trig_sin, FloatFloat, reduced, __private int, *quadrant, {
+	// explicitly calculate both variants to prevent clang from converting the ?:-operator to an if-else block
+	float_t cosine;
+	float_t sine = vc4cl_sincos_reduced(reduced, &cosine);
+	float_t result = (*quadrant & 1) != 0 ? cosine : sine;
+	return (*quadrant & 2) != 0 ? -result : result;
+})
+
+/*
+ * Calculates the cosine of quadrant * pi/2 + reduced, where the quadrant is read after the reduced argument (and
+ * therefore the quadrant) was calculated.
+ */
+COMPLEX_2(float, vc4cl_trig_cos, FloatFloat, reduced, __private int, *quadrant, {
+	// explicitly calculate both variants to prevent clang from converting the ?:-operator to an if-else block
+	float_t cosine;
+	float_t sine = vc4cl_sincos_reduced(reduced, &cosine);
+	float_t result = (*quadrant & 1) != 0 ? -sine : cosine;
+	return (*quadrant & 2) != 0 ? -result : result;
+})
+
+/*
+ * Calculates both the sine and cosine of quadrant * pi/2 + reduced, where the quadrant is read after the reduced
+ * argument (and therefore the quadrant) was calculated. Returns the sine and stores the cosine in the output parameter.
+ *
+ * sin(x + pi/2) = cos(x), cos(x + pi/2) = -sin(x) and sin(x + pi) = -sin(x), cos(x + pi) = -cos(x)
+ */
+COMPLEX_3(float, vc4cl_trig_sincos, FloatFloat, reduced, __private int, *quadrant, __private float, *cosval, {
+	result_t cosine;
+	result_t sine = vc4cl_sincos_reduced(reduced, &cosine);
+	int_t swap = (*quadrant & 1) != 0;
+	int_t negateSine = (*quadrant & 2) != 0;
+	// the cosine is negated in the quadrants 1 and 2
+	int_t negateCosine = ((*quadrant + 1) & 2) != 0;
+	result_t resultSine = swap ? cosine : sine;
+	result_t resultCosine = swap ? sine : cosine;
+	*cosval = negateCosine ? -resultCosine : resultCosine;
+	return negateSine ? -resultSine : resultSine;
+})
+
+/*
+ * Calculates the tangent of quadrant * pi/2 + reduced, where the quadrant is read after the reduced argument (and
+ * therefore the quadrant) was calculated.
+ *
+ * Uses the minimax polynomial of the Cephes library (http://www.netlib.org/cephes/) for the range [-pi/4, pi/4] and
+ * the reflection tan(x + pi/2) = -cot(x) = -1 / tan(x) for the odd quadrants, which requires only a single division.
+ *
+ * The result is calculated as upper + lower part, where the lower part contains the rounding error of the final
+ * addition and the correction for the lower part of the reduced argument: tan(x + y) ~ tan(x) + y * (1 + tan(x)^2).
+ * For the reflection, this gives -1 / (upper + lower) ~ -1 / upper + lower / upper^2.
+ *
+ * Max error (tested on host): 3 ULP for [0, 2^15]
+ */
+COMPLEX_2(float, vc4cl_trig_tan, FloatFloat, reduced, __private int, *quadrant, {
+	float_t x = vc4cl_upper(reduced);
+	float_t z = x * x;
+	float_t poly = (((((9.38540185543e-3f * z + 3.11992232697e-3f) * z + 2.44301354525e-2f) * z + 5.34112807005e-2f) * z +
+		1.33387994085e-1f) * z + 3.33331568548e-1f) * z * x;
+	float_t upper = x + poly;
+	float_t lower = (poly - (upper - x)) + vc4cl_lower(reduced) * (1.0f + upper * upper);
+	float_t reciprocal = -1.0f / upper;
+	// tan(x) = +-0 in the odd quadrants (only for tanpi) gives a NaN correction term
+	float_t cotangent = isinf(reciprocal) ? reciprocal : reciprocal + reciprocal * reciprocal * lower;
+	return (*quadrant & 1) != 0 ? cotangent : upper + lower;
+})
+
+/*
+ * Calculates the sine and cosine of the argument with reduced accuracy for the half and native trigonometric functions.
+ * Returns the sine and stores the cosine in the output parameter, both for the reduced argument in [-pi/4, pi/4], so the
+ * caller needs to apply the quadrant.
+ *
+ * The argument is reduced with a Cody-Waite reduction in single precision, where pi/2 is split into parts of which all
+ * but the last have only 8 significant bits, so that quadrant * part is exact for all |x| <= 2^16 (the range required
+ * for the half functions). The sine and cosine are approximated with minimax polynomials of degree 5 and 4 (absolute
+ * errors < 2^-19 and 2^-16).
+ *
+ * Max error (tested on host, for |x| <= 2^16):
+ * - 212 ULP for the sine
+ * - 1813 ULP for the cosine
+ * - 3060 ULP for the tangent (calculated as sine / cosine)
+ */
+COMPLEX_3(float, vc4cl_sincos_fast, float, val, __private int, *quadrant, __private float, *cosval, {
+	result_t k = rint(val * M_2_PI_F);
+	result_t x = val - k * 0x1.92p+0f;
+	x = x - k * 0x1.fcp-12f;
+	x = x + k * 0x1.58p-21f;
+	x = x - k * 0x1.10b462p-30f;
+	*quadrant = vc4cl_ftoi(k) & 3;
+	result_t z = x * x;
+	*cosval = 1.0f + z * (-4.9977630377e-01f + z * 4.0488928556e-02f);
+	return x + x * z * (-1.6663458943e-01f + z * 8.1646079198e-03f);
 })
 
 /**
  * Expected behavior:
  *
- * cosh(+-0) = 1
- * cosh(+-Inf) = +-Inf
+ * cos(+-0) = 1
+ * cos(+-Inf) = NaN for |x| > 1
  */
-COMPLEX_1(float, cosh, float, val, {
+#ifdef VC4CL_RELAXED_MATH
+SIMPLE_1(float, cos, float, val, half_cos(val))
+#elif VC4CL_ALLOWS_ULP(8192)
+COMPLEX_1(float, cos, float, val, {
+	result_t result = half_cos(val);
+	// MSB of the difference is set, if the value is larger than 2^16 (or Inf), for which the reduction of half_cos is no
+	// longer exact, see vc4cl_sincos_fast
+	if(any((int_t) 0x47800000 - vc4cl_bitcast_int(fabs(val))))
+	{
+		int_t quadrant;
+		result_t exact = vc4cl_trig_cos(vc4cl_trig_reduce(fabs(val), &quadrant), &quadrant);
+		result = fabs(val) > (arg_t) 0x1.0p16f ? exact : result;
+	}
+	return result;
+})
+#else
+COMPLEX_1(float, cos, float, val, {
 	/*
-	 * https://en.wikipedia.org/wiki/Taylor_series#Approximation_and_convergence
-	 *
-	 * This version (the Taylor-series up to x^16/16!) has following accuracy:
-	 *
-	 * cosh(PI) -> error of 1.5*10^-7 < ulp(PI) = 2*10^-7
-	 * cosh(0.5f) -> error of < 10^-9 < ulp(0.5f) = 5*10^-8
-	 * cosh(0.0f) -> error of < 10^-46 < ulp(0.0f) = 1*10^-45
-	 *
 	 * OpenCL 1.2 EMBEDDED PROFILE allows an error of up to 4 ulp
-	 */
-	const result_t fac2 = 1.0f / factorial(2);
-	const result_t fac4 = 1.0f / factorial(4);
-	const result_t fac6 = 1.0f / factorial(6);
-	const result_t fac8 = 1.0f / factorial(8);
-	const result_t fac10 = 1.0f / factorial(10);
-	const result_t fac12 = 1.0f / factorial(12);
-	const result_t fac14 = 1.0f / factorial(14);
-	const result_t fac16 = 1.0f / factorial(16);
-
-	/*
-	 * Argument reduction
 	 *
-	 * Matters Computational, section 32.2.3
+	 * We use argument reduction to bring it into range [-pi/4, pi/4] in which range the polynomial approximation is
+	 * accurate. Since cosine is an even function, the reduction only needs to handle positive values.
+	 * Inf and NaN result in NaN in the argument reduction.
 	 */
-	const uint n = 12;
-	// r = x / 2^n
-	const result_t inv2N = 1.0f / (1 << n);
-	result_t r = val * inv2N;
-
-	// C = cosh(r) - 1
-	result_t x = r;
-
-	result_t x2 = x * x;
-	result_t tmp1 = x2 * fac2;
-	// cosh(x) = 1 + x^2/2! + ...
-	result_t tmp = 1 + tmp1;
-	result_t x4 = x2 * x * x;
-	tmp1 = x4 * fac4;
-	//... + x^4/4! + ...
-	tmp = x + tmp1;
-	result_t x6 = x4 * x * x;
-	tmp1 = x6 * fac6;
-	//... + x^6/6! + ...
-	tmp = tmp + tmp1;
-	result_t x8 = x6 * x * x;
-	tmp1 = x8 + fac8;
-	//... + x^8/8! + ...
-	tmp = tmp + tmp1;
-	result_t x10 = x8 * x * x;
-	tmp1 = x10 * fac10;
-	//... + x^10/10! + ...
-	tmp = tmp + tmp1;
-	result_t x12 = x10 * x * x;
-	tmp1 = x12 + fac12;
-	//... + x^12/12! + ...
-	tmp = tmp + tmp1;
-	result_t x14 = x12 * x * x;
-	tmp1 = x14 * fac14;
-	//... + x^14/14! + ...
-	tmp = tmp + tmp1;
-	result_t x16 = x14 * x * x;
-	tmp1 = x16 + fac16;
-	//... + x^16/16!
-	tmp = tmp + tmp1;
-
-	result_t C = tmp - 1;
-	for(uint i = 0; i < n; ++i)
-		C = 2 * (C + 1) * (C + 1) - 2;
-	return C + 1;
+	int_t quadrant;
+	return vc4cl_trig_cos(vc4cl_trig_reduce(fabs(val), &quadrant), &quadrant);
 })
+#endif
 
 /**
  * Expected behavior:
@@ -456,39 +621,97 @@ COMPLEX_1(float, cosh, float, val, {
  * cospi(x) = +0 for x = n + 0.5 and n is integer
  * cospi(+-Inf) = NaN
  */
-SIMPLE_1(float, cospi, float, val, cos(val *M_PI_F))
+COMPLEX_1(float, cospi, float, val, {
+	// The reduction of the pi-scaled argument is exact, so there is no error introduced by multiplying with pi first
+	int_t quadrant;
+	result_t result = vc4cl_trig_cos(vc4cl_trig_reduce_pi(fabs(val), &quadrant), &quadrant);
+	// -0 + +0 = +0, converts the zero result for x = n + 0.5 to +0 and leaves all other values unchanged
+	return result + 0.0f;
+})
 
-/**
- * Expected behavior:
+/*
+ * Returns 2^(index / 8) for index in [0, 7] in extended precision.
  *
- * erfc(-Inf) = 2
- * erfc(+Inf) = 0
+ * Since there is no efficient way to index into a constant table with vector indices, the table lookup is implemented
+ * as tree of selections on the bits of the index.
  */
-SIMPLE_1(float, erfc, float, x, 1 - erf(x))
+COMPLEX_1(FloatFloat, vc4cl_exp2_table, int, index, {
+	int_t bit0 = (index & 1) != 0;
+	int_t bit1 = (index & 2) != 0;
+	int_t bit2 = (index & 4) != 0;
+	float_t upper0 = bit0 ? (float_t) 0x1.172b84p+0f : (float_t) 0x1.0p+0f;
+	float_t upper1 = bit0 ? (float_t) 0x1.4bfdaep+0f : (float_t) 0x1.306fe0p+0f;
+	float_t upper2 = bit0 ? (float_t) 0x1.8ace54p+0f : (float_t) 0x1.6a09e6p+0f;
+	float_t upper3 = bit0 ? (float_t) 0x1.d5818ep+0f : (float_t) 0x1.ae89fap+0f;
+	float_t lower0 = bit0 ? (float_t) -0x1.c15742p-27f : (float_t) 0.0f;
+	float_t lower1 = bit0 ? (float_t) -0x1.593abcp-25f : (float_t) 0x1.4636e2p-25f;
+	float_t lower2 = bit0 ? (float_t) 0x1.15506ep-27f : (float_t) 0x1.9fcef4p-26f;
+	float_t lower3 = bit0 ? (float_t) -0x1.822dbcp-27f : (float_t) -0x1.a94b14p-26f;
+	upper0 = bit1 ? upper1 : upper0;
+	upper2 = bit1 ? upper3 : upper2;
+	lower0 = bit1 ? lower1 : lower0;
+	lower2 = bit1 ? lower3 : lower2;
+	return vc4cl_combine(bit2 ? upper2 : upper0, bit2 ? lower2 : lower0);
+})
 
-/**
- * Expected behavior:
+/*
+ * Calculates 2^x for the extended precision argument and returns the result in extended precision.
  *
- * erf(+-0) = +-0
- * erf(+-Inf) = +-1
+ * Range reduction: x = k / 8 + r with |r| <= 1/16 and k = 8 * m + j, which gives 2^x = 2^m * 2^(j / 8) * 2^r.
+ * 2^(j / 8) is read from a table in extended precision and 2^r - 1 is approximated with a minimax polynomial of degree
+ * 4 (relative error < 2^-28).
+ *
+ * The result is calculated as 2^m * (T + (T * (2^r - 1) + T_lower)). The final addition is kept in extended
+ * precision, which allows e.g. expm1 to subtract 1 without loss of precision.
+ *
+ * NOTE: NaN arguments are not handled and need to be checked by the caller!
  */
-COMPLEX_1(float, erf, float, x, {
-	/*
-	 * https://en.wikipedia.org/wiki/Error_function#Numerical_approximations
-	 *
-	 * has a maximal error of 1.2 * 10^-7
-	 *
-	 * alternative: http://mathworld.wolfram.com/Erf.html
-	 */
-	const result_t t = 1 / (1 + 0.5f * fabs(x));
-
-	const result_t r = t *
-		exp(-x * x - 1.26551223f + 1.00002368f * t + 0.37409196f * t * t + 0.09678418f * t * t * t -
-			0.18628806f * t * t * t * t + 0.27886807f * t * t * t * t * t - 1.13520398f * t * t * t * t * t * t +
-			1.48851587f * t * t * t * t * t * t * t - 0.82215223f * t * t * t * t * t * t * t * t +
-			0.17087277f * t * t * t * t * t * t * t * t * t);
+COMPLEX_1(FloatFloat, vc4cl_exp2_extended, FloatFloat, val, {
+	float_t upper = vc4cl_upper(val);
+	// for values outside of this range, the lower part might be arbitrarily large or even NaN (if the calculation of the
+	// argument overflowed), but the result is Inf or zero anyway
+	float_t lower = fabs(upper) < 256.0f ? vc4cl_lower(val) : (float_t) 0.0f;
+	upper = clamp(upper, (float_t) -160.0f, (float_t) 130.0f);
+	float_t k = rint(upper * 8.0f);
+	// upper - k / 8 is exact
+	float_t r = (upper - k * 0.125f) + lower;
+	int_t kInt = vc4cl_ftoi(k);
+	result_t table = vc4cl_exp2_table(kInt & 7);
+	float_t poly = r * (6.9314718246e-01f + r * (2.4022650719e-01f + r * (5.5509328842e-02f + r * 9.6181286499e-03f)));
+	float_t tableUpper = vc4cl_upper(table);
+	float_t tail = tableUpper * poly + vc4cl_lower(table);
+	// fast two-sum, since |tableUpper| > |tail|
+	float_t sum = tableUpper + tail;
+	tail = tail - (sum - tableUpper);
+	// scale by 2^m in two steps, since 2^m alone can not be represented for all m (e.g. 2^128 for results slightly
+	// below FLT_MAX). The scaling is applied to the already rounded sum, so the result overflows at the correct value
+	int_t m = kInt >> 3;
+	float_t scale0 = vc4cl_pow2(m >> 1);
+	float_t scale1 = vc4cl_pow2(m - (m >> 1));
+	return vc4cl_combine((sum * scale0) * scale1, (tail * scale0) * scale1);
+})
 
-	return x < 0 ? r - 1 : 1 - r;
+/*
+ * Calculates e^x in single precision for the faster accuracy tier of exp (see VC4CL_MATH_ACCURACY).
+ *
+ * Range reduction: x = k * log(2) + r with |r| <= log(2) / 2, where log(2) is split into two parts, of which the first
+ * has only 15 significant bits, so that k * part is exact. e^r is approximated as 1 + r + r^2 * P(r), where P is a
+ * minimax polynomial of degree 4, and the result is scaled by 2^k in two steps (see vc4cl_exp2_extended).
+ *
+ * Max error (tested on host): 1 ULP
+ *
+ * NOTE: NaN arguments are not handled and need to be checked by the caller!
+ */
+COMPLEX_1(float, vc4cl_exp_fast, float, val, {
+	// values outside of this range overflow (to Inf or zero) anyway
+	arg_t x = clamp(val, (arg_t) -104.0f, (arg_t) 89.0f);
+	arg_t k = rint(x * M_LOG2E_F);
+	arg_t r = (x - k * 0x1.62e4p-1f) - k * 0x1.7f7d1cp-20f;
+	result_t poly = 4.9999994040e-01f +
+		r * (1.6666521132e-01f + r * (4.1668388993e-02f + r * (8.3687165380e-03f + r * 1.3814599253e-03f)));
+	result_t result = 1.0f + (r + r * r * poly);
+	int_t m = vc4cl_ftoi(k);
+	return (result * vc4cl_pow2(m >> 1)) * vc4cl_pow2(m - (m >> 1));
 })
 
 /**
@@ -497,48 +720,25 @@ COMPLEX_1(float, erf, float, x, {
  * exp(+-0) = 1
  * exp(-Inf) = 0
  * exp(+Inf) = +Inf
- *
- * Chebyshev interpolation with monomial basis and range reduction,
- *
- * https://www.pseudorandom.com/implementing-exp#section-18
  */
+#if VC4CL_ALLOWS_ULP(8192)
+SIMPLE_1(float, exp, float, val, native_exp(val))
+#elif VC4CL_ALLOWS_ULP(1)
 COMPLEX_1(float, exp, float, val, {
-
-	arg_t positive = fabs(val);
-
-	// range reduction: e^x = 2^k * e^r [with x = r + k * log2(x)]
-
-	// Use floor() instead of ceil() to not reach Inf later on for e^(~10^38)
-	int_t k = vc4cl_ftoi((positive / M_LN2_F) - 0.5f);
-	arg_t kFloat = vc4cl_itof(k);
-	// calculate in extended precision to reduce rounding error
-	arg_t r = vc4cl_lossy(vc4cl_sub(vc4cl_extend(positive), vc4cl_mul(vc4cl_extend(kFloat), M_LN2_FF)));
-
-	arg_t pn = 1.143364767943110e-11;
-
-	pn = pn * r + 1.632461784798319e-10f;
-	pn = pn * r + 2.088459690899721e-9f;
-	pn = pn * r + 2.504861486483735e-8f;
-	pn = pn * r + 2.755715675968011e-7f;
-	pn = pn * r + 2.755734045527853e-6f;
-	pn = pn * r + 2.480158866546844e-5f;
-	pn = pn * r + 1.984126978734782e-4f;
-	pn = pn * r + 0.001388888888388f;
-	pn = pn * r + 0.008333333333342f;
-	pn = pn * r + 0.041666666666727f;
-	pn = pn * r + 0.166666666666680f;
-	pn = pn * r + 0.500000000000002f;
-	pn = pn * r + 1.000000000000000f;
-	pn = pn * r + 1.000000000000000f;
-
-	pn = pn * vc4cl_pow2(k);
-	result_t result = val < 0 ? 1 / pn : pn;
-
-	result = vc4cl_is_zero(val) ? (result_t)1.0f : result;
-	result = val <= (result_t)-88.0f ? (result_t)0.0f : result;
-	result = val >= (result_t)89.0f ? (result_t)INFINITY : result;
-	return isnan(val) ? val : result;
+	result_t result = vc4cl_exp_fast(val);
+	return VC4CL_CHECK_NAN(val) ? val : result;
+})
+#else
+COMPLEX_1(float, exp, float, val, {
+	// e^x = 2^(x * log2(e)), the product is calculated in extended precision, since its error is magnified by the
+	// magnitude of the argument. Values outside of [-200, 200] overflow (to Inf or zero) anyway, but could overflow the
+	// extended precision multiplication.
+	// The upper part of the result is already rounded, so there is no need to add the lower part.
+	arg_t limited = clamp(val, (arg_t) -200.0f, (arg_t) 200.0f);
+	result_t result = vc4cl_upper(vc4cl_exp2_extended(vc4cl_mul(vc4cl_extend(limited), M_LOG2E_FF)));
+	return VC4CL_CHECK_NAN(val) ? val : result;
 })
+#endif
 
 /**
  * Expected behavior:
@@ -547,12 +747,12 @@ COMPLEX_1(float, exp, float, val, {
  * exp2(-Inf) = 0
  * exp2(+Inf) = +Inf
  */
-
+#ifndef VC4CL_RELAXED_MATH
 COMPLEX_1(float, exp2, float, val, {
-	// 2^x = e^(x * ln(2))
-	result_t result = exp(val * M_LN2_F);
-	return isnan(val) ? val : result;
+	result_t result = vc4cl_upper(vc4cl_exp2_extended(vc4cl_extend(val)));
+	return VC4CL_CHECK_NAN(val) ? val : result;
 })
+#endif
 
 /**
  * Expected behavior:
@@ -561,11 +761,18 @@ COMPLEX_1(float, exp2, float, val, {
  * exp10(-Inf) = 0
  * exp10(+Inf) = +Inf
  */
+#ifndef VC4CL_RELAXED_MATH
 COMPLEX_1(float, exp10, float, val, {
-	// 10^x = e^(x / log10(e))
-	result_t result = exp(val * M_1_LOG10_E_F);
-	return isnan(val) ? val : result;
+	// 10^x = 2^(x * log2(10)), see exp for the limitation of the argument
+	arg_t limited = clamp(val, (arg_t) -200.0f, (arg_t) 200.0f);
+	result_t result = vc4cl_upper(vc4cl_exp2_extended(vc4cl_mul(vc4cl_extend(limited), M_LOG2_10_FF)));
+	return VC4CL_CHECK_NAN(val) ? val : result;
 })
+#endif
+
+// Calculates (upper + lower) - 1, the subtraction is exact for upper in [0.5, 2], which keeps the precision for small
+// results (e.g. for expm1), where the result is mostly contained in the lower part
+SIMPLE_1(float, vc4cl_sub_one, FloatFloat, val, (vc4cl_upper(val) - 1.0f) + vc4cl_lower(val))
 
 /**
  * Expected behavior:
@@ -576,8 +783,111 @@ COMPLEX_1(float, exp10, float, val, {
  */
 // e^x - 1.0
 COMPLEX_1(float, expm1, float, val, {
-	result_t result = exp(val) - 1.0f;
-	return isnan(val) ? val : result;
+	// See exp for the limitation of the argument
+	arg_t limited = clamp(val, (arg_t) -200.0f, (arg_t) 200.0f);
+	result_t result = vc4cl_sub_one(vc4cl_exp2_extended(vc4cl_mul(vc4cl_extend(limited), M_LOG2E_FF)));
+	result = vc4cl_is_zero(val) ? val : result;
+	return VC4CL_CHECK_NAN(val) ? val : result;
+})
+
+/*
+ * Calculates erf(x) for |x| < 0.5 as x + x * P(x^2) with a minimax polynomial P of degree 4 (relative error ~2^-29).
+ */
+COMPLEX_1(float, vc4cl_erf_small, float, x, {
+	arg_t z = x * x;
+	result_t p = 0.0047179959f;
+	p = p * z - 0.026757188f;
+	p = p * z + 0.11282823f;
+	p = p * z - 0.37612608f;
+	p = p * z + 0.12837917f;
+	return x + x * p;
+})
+
+/*
+ * Calculates erfc(x) for x >= 0.5 as e^(-x^2) * R(t), where R approximates the scaled complementary error function
+ * erfcx(x) = e^(x^2) * erfc(x) with a minimax polynomial of degree 9 in t = 1 / (1 + x / 2) (relative error ~2^-29).
+ *
+ * Since the error of the exponent is magnified by its magnitude, e^(-x^2) is calculated from the exact square in
+ * extended precision. The result underflows for x > ~10.05, larger values are clamped to not overflow the extended
+ * precision calculations.
+ */
+COMPLEX_1(float, vc4cl_erfc_tail, float, val, {
+	arg_t x = fmin(val, (arg_t) 11.0f);
+	arg_t t = 1.0f / (1.0f + 0.5f * x);
+	result_t r = -0.074440971f;
+	r = r * t + 0.35137400f;
+	r = r * t - 0.61124831f;
+	r = r * t + 0.40674329f;
+	r = r * t - 0.10843365f;
+	r = r * t + 0.23559928f;
+	r = r * t + 0.23476021f;
+	r = r * t + 0.28365573f;
+	r = r * t + 0.28197879f;
+	r = r * t + 3.7664311e-06f;
+	return vc4cl_upper(vc4cl_exp2_extended(vc4cl_mul(vc4cl_mul(-x, x), M_LOG2E_FF))) * r;
+})
+
+/**
+ * Expected behavior:
+ *
+ * erf(+-0) = +-0
+ * erf(+-Inf) = +-1
+ */
+COMPLEX_1(float, erf, float, x, {
+	// erf(x) = 1 - erfc(x) for |x| >= 0.5 does not cancel, since erfc(x) <= 0.48
+	// Max error (tested on host): 3 ULP
+	arg_t absX = fabs(x);
+	result_t result = absX < 0.5f ? vc4cl_erf_small(x) : copysign(1.0f - vc4cl_erfc_tail(absX), x);
+	return VC4CL_CHECK_NAN(x) ? x : result;
+})
+
+/**
+ * Expected behavior:
+ *
+ * erfc(-Inf) = 2
+ * erfc(+Inf) = 0
+ */
+COMPLEX_1(float, erfc, float, x, {
+	// erfc(x) = 1 - erf(x) for |x| < 0.5 does not cancel, since erf(x) < 0.53, erfc(-x) = 2 - erfc(x)
+	// Max error (tested on host): 6 ULP
+	arg_t absX = fabs(x);
+	result_t tail = vc4cl_erfc_tail(absX);
+	result_t result = absX < 0.5f ? 1.0f - vc4cl_erf_small(x) : (x < 0.0f ? 2.0f - tail : tail);
+	return VC4CL_CHECK_NAN(x) ? x : result;
+})
+
+/*
+ * Calculates e^x in extended precision for the hyperbolic functions, where x is non-negative.
+ *
+ * sinh(x) and cosh(x) only overflow for x > ~89.4, while e^x already overflows for x > ~88.7. To cover the whole range,
+ * e^x / 2 (which is then equal to sinh(x) and cosh(x) in single precision) is returned for x > 88.
+ *
+ * The result keeps the precision of vc4cl_exp2_extended, so e^x - 1 can be calculated via vc4cl_sub_one without loss of
+ * precision for small x.
+ */
+COMPLEX_1(FloatFloat, vc4cl_exp_hyperbolic, float, val, {
+	// values above 90 overflow anyway, but could overflow the extended precision multiplication
+	result_t exponent = vc4cl_mul(vc4cl_extend(fmin(val, (arg_t) 90.0f)), M_LOG2E_FF);
+	float_t upper = vc4cl_upper(exponent);
+	// the upper part is > 126 for x > 88, so the subtraction is exact
+	upper = val > (arg_t) 88.0f ? upper - 1.0f : upper;
+	return vc4cl_exp2_extended(vc4cl_combine(upper, vc4cl_lower(exponent)));
+})
+
+/**
+ * Expected behavior:
+ *
+ * cosh(+-0) = 1
+ * cosh(+-Inf) = +Inf
+ */
+COMPLEX_1(float, cosh, float, val, {
+	// cosh(x) = (e^|x| + e^-|x|) / 2, there is no cancellation and the rounding errors of e^|x| and e^-|x| cancel each
+	// other out for small x. For large x, e^-|x| is negligible.
+	// Max error (tested on host): 2 ULP
+	arg_t absVal = fabs(val);
+	arg_t e = vc4cl_upper(vc4cl_exp_hyperbolic(absVal));
+	result_t result = absVal > (arg_t) 88.0f ? e : 0.5f * e + 0.5f / e;
+	return VC4CL_CHECK_NAN(val) ? val : result;
 })
 
 /**
@@ -597,8 +907,8 @@ SIMPLE_1(float, fabs, float, val, vc4cl_fmaxabs(val, 0.0f))
 //"x-y if x>y, +0 if x is less than or equal to y."
 COMPLEX_2(float, fdim, float, x, float, y, {
 	result_t result = x > y ? x - y : 0.0f;
-	result = isnan(x) ? x : result;
-	return isnan(y) ? y : result;
+	result = VC4CL_CHECK_NAN(x) ? x : result;
+	return VC4CL_CHECK_NAN(y) ? y : result;
 })
 
 /**
@@ -609,36 +919,101 @@ COMPLEX_2(float, fdim, float, x, float, y, {
  */
 COMPLEX_1(float, floor, float, val, {
 	//" Round to integer toward negative infinity. "
-
-	// https://stackoverflow.com/questions/12279914/implement-ceil-in-c
-	// http://blog.frama-c.com/index.php?post/2013/05/02/nearbyintf1
-	// all floating point values |val| > 2^23 are exact numbers
-	int_t tooBig = isnan(val) || fabs(val) >= 0x1.0p23f;
-	// |val| < 2^23 fits into integer
-	result_t truncated = vc4cl_itof(vc4cl_ftoi(val));
-	// if the truncation is greater than val (negative numbers), subtract 1 to round down
-	result_t floor_val = truncated - (truncated > val ? (result_t)1.0f : (result_t)0.0f);
-	// deciding here which value to return saves us up to two jumps
-	return tooBig ? val : floor_val;
+	int_t bits = vc4cl_bitcast_int(val);
+	int_t mask = vc4cl_fraction_mask(bits);
+	result_t truncated = vc4cl_bitcast_float(bits & ~mask);
+	// negative values with a fractional part are rounded down
+	return (bits & mask) != 0 && bits < 0 ? truncated - 1.0f : truncated;
 })
 
 /**
  * Expected behavior:
  *
  * fma(x, y, z) = xy + z
- * fma(x, y, z) = NaN for x = 0 or y = 0
- * fma(x, y, z)= NaN for x = Inf, y = Inf, z = Inf
+ * fma(x, y, z) = NaN for x = 0 and y = Inf (or vice versa)
+ * fma(x, y, z) = NaN for xy = +-Inf and z = -+Inf
+ * fma(x, y, z) = z for x, y finite and z = +-Inf
  */
-// TODO not "infinitely precise product" and maybe not "correctly rounded"
-SIMPLE_3(float, fma, float, a, float, b, float, c, (a * b) + c)
+// The product is calculated exactly in extended precision and the sum is rounded only once. Since the product can
+// overflow even if the sum is finite, large factors are scaled down, which is exact as long as the (scaled) summand does
+// not become subnormal.
+// The result is correctly rounded, unless the product is smaller than ~2^-100 (where the error term of the product is
+// subnormal), in which case the error is at most 1 ULP.
+COMPLEX_3(float, fma, float, a, float, b, float, c, {
+	int_t largeA = fabs(a) >= (arg0_t) 0x1.0p64f;
+	int_t largeB = fabs(b) >= (arg1_t) 0x1.0p64f;
+	result_t scaleA = largeA ? (result_t) 0x1.0p-32f : (result_t) 1.0f;
+	result_t scaleB = largeB ? (result_t) 0x1.0p-32f : (result_t) 1.0f;
+	result_t inverseScale =
+		(largeA ? (result_t) 0x1.0p32f : (result_t) 1.0f) * (largeB ? (result_t) 0x1.0p32f : (result_t) 1.0f);
+	result_t result = vc4cl_add_rounded(vc4cl_mul(a * scaleA, b * scaleB), c * (scaleA * scaleB)) * inverseScale;
+	// overflowing products and Inf/NaN arguments result in NaN in the extended precision calculation
+	result = isnan(result) ? (a * b) + c : result;
+	return VC4CL_CHECK_INF(c) && !VC4CL_CHECK_INF_NAN(a) && !VC4CL_CHECK_INF_NAN(b) ? c : result;
+})
 
 // The fmax/min ALU operations (vc4cl_fmax/vc4cl_fmin) handle NaNs as bigger then all, we need to handle them as:
 // " If one argument is a NaN, fmin/fmax() returns the other argument. If both arguments are NaNs, fmin/fmax() returns a NaN."
-SIMPLE_2(float, fmax, float, x, float, y, isnan(x) ? y : isnan(y) ? x : vc4cl_fmax(x, y))
-SIMPLE_2_SCALAR(float, fmax, float, x, float, y, isnan(x) ? y : isnan(y) ? x : vc4cl_fmax(x, y))
+SIMPLE_2(float, fmax, float, x, float, y, VC4CL_CHECK_NAN(x) ? y : VC4CL_CHECK_NAN(y) ? x : vc4cl_fmax(x, y))
+SIMPLE_2_SCALAR(float, fmax, float, x, float, y, VC4CL_CHECK_NAN(x) ? y : VC4CL_CHECK_NAN(y) ? x : vc4cl_fmax(x, y))
 
-SIMPLE_2(float, fmin, float, x, float, y, isnan(x) ? y : isnan(y) ? x : vc4cl_fmin(x, y))
-SIMPLE_2_SCALAR(float, fmin, float, x, float, y, isnan(x) ? y : isnan(y) ? x : vc4cl_fmin(x, y))
+SIMPLE_2(float, fmin, float, x, float, y, VC4CL_CHECK_NAN(x) ? y : VC4CL_CHECK_NAN(y) ? x : vc4cl_fmin(x, y))
+SIMPLE_2_SCALAR(float, fmin, float, x, float, y, VC4CL_CHECK_NAN(x) ? y : VC4CL_CHECK_NAN(y) ? x : vc4cl_fmin(x, y))
+
+/*
+ * Calculates x modulo y for positive finite x and y (y non-zero) exactly with a long division of the mantissas on the
+ * integer ALU. Returns the remainder and stores the lowest 16 bits of the (truncated) integral quotient in the output
+ * parameter.
+ *
+ * Every step shifts the remainder by up to 7 bits and calculates the next digit of the quotient (base 2^7) from the
+ * reciprocal of the divisor. Since the shifted remainder has at most 31 bits, even the SFU reciprocal gives an estimate
+ * which is off by at most one, which is corrected with the exact remainder. The number of steps is the difference of
+ * the exponents divided by 7, rounded up. To not branch on the data, all elements run the maximum of 40 steps (for the
+ * largest x and the smallest subnormal y), the results of the steps after an element is done are discarded.
+ */
+COMPLEX_3(float, vc4cl_fmod_positive, float, x, float, y, __private int, *quotient, {
+	int_t bitsX = vc4cl_bitcast_int(x);
+	int_t bitsY = vc4cl_bitcast_int(y);
+	int_t exponentX = bitsX >> 23;
+	int_t exponentY = bitsY >> 23;
+	int_t mantissaX = bitsX & (int_t) 0x007FFFFF;
+	int_t mantissaY = bitsY & (int_t) 0x007FFFFF;
+	// normalize subnormal values, otherwise add the implicit leading one
+	int_t shiftX = vc4cl_clz(mantissaX) - (32 - 24);
+	int_t shiftY = vc4cl_clz(mantissaY) - (32 - 24);
+	mantissaX = exponentX == 0 ? mantissaX << shiftX : mantissaX | (int_t) 0x00800000;
+	mantissaY = exponentY == 0 ? mantissaY << shiftY : mantissaY | (int_t) 0x00800000;
+	exponentX = exponentX == 0 ? 1 - shiftX : exponentX;
+	exponentY = exponentY == 0 ? 1 - shiftY : exponentY;
+
+	int_t steps = exponentX - exponentY;
+	// first step without the shift, for x < y the remainder is x and the quotient zero
+	int_t fits = mantissaX >= mantissaY && steps >= 0;
+	mantissaX = fits ? mantissaX - mantissaY : mantissaX;
+	int_t quot = fits & 1;
+	float_t reciprocal = vc4cl_sfu_recip(vc4cl_itof(mantissaY));
+	int_t remaining = max(steps, (int_t) 0);
+	for(int i = 0; i < 40; ++i)
+	{
+		int_t shift = min(remaining, (int_t) 7);
+		int_t shifted = mantissaX << shift;
+		int_t digit = vc4cl_ftoi(vc4cl_itof(shifted) * reciprocal);
+		int_t remainder = shifted - vc4cl_mul24(digit, mantissaY, VC4CL_UNSIGNED);
+		int_t tooLarge = remainder < 0;
+		int_t tooSmall = remainder >= mantissaY;
+		digit = tooLarge ? digit - 1 : (tooSmall ? digit + 1 : digit);
+		remainder = tooLarge ? remainder + mantissaY : (tooSmall ? remainder - mantissaY : remainder);
+		// for x < y, the mantissa of x can still be larger than the one of y, so the finished elements are masked
+		int_t active = remaining > 0;
+		mantissaX = active ? remainder : mantissaX;
+		quot = active ? ((quot << shift) | digit) & 0xFFFF : quot;
+		remaining -= shift;
+	}
+	*quotient = steps >= 0 ? quot : 0;
+	// the remainder is exact and has the exponent of y (or x for x < y), scale in two steps for subnormal results
+	int_t exponent = (steps >= 0 ? exponentY : exponentX) - (127 + 23);
+	return vc4cl_itof(mantissaX) * vc4cl_pow2(exponent >> 1) * vc4cl_pow2(exponent - (exponent >> 1));
+})
 
 /**
  * Expected behavior:
@@ -650,10 +1025,14 @@ SIMPLE_2_SCALAR(float, fmin, float, x, float, y, isnan(x) ? y : isnan(y) ? x : v
  */
 //"Modulus. Returns x - y * trunc(x/y)"
 COMPLEX_2(float, fmod, float, x, float, y, {
-	result_t result = x - y * trunc(x / y);
-	result = (isinf(x) || sign(y) == (result_t)0.0f) ? (result_t)nan(0) : result;
-	result = (isinf(y) || isnan(x)) ? x : result;
-	return isnan(y) ? y : result;
+	int_t quotient;
+	result_t result = vc4cl_fmod_positive(fabs(x), fabs(y), &quotient);
+	// the result has the sign of x
+	result = vc4cl_bitcast_float(vc4cl_bitcast_uint(result) | (vc4cl_bitcast_uint(x) & 0x80000000));
+	result = (VC4CL_CHECK_INF(y) || vc4cl_is_zero(x)) ? x : result;
+	result = (VC4CL_CHECK_INF(x) || vc4cl_is_zero(y)) ? (result_t)nan(0) : result;
+	result = VC4CL_CHECK_NAN(x) ? x : result;
+	return VC4CL_CHECK_NAN(y) ? y : result;
 })
 
 /**
@@ -671,7 +1050,7 @@ COMPLEX_2(float, fract, float, val, __global float, *iptr, {
 	result_t tmp = floor(val);
 	*iptr = tmp;
 	tmp = fmin(val - tmp, 0x1.fffffep-1f);
-	return isnan(val) ? val : tmp;
+	return VC4CL_CHECK_NAN(val) ? val : tmp;
 })
 
 COMPLEX_2(float, fract, float, val, __local float, *iptr, {
@@ -679,7 +1058,7 @@ COMPLEX_2(float, fract, float, val, __local float, *iptr, {
 	result_t tmp = floor(val);
 	*iptr = tmp;
 	tmp = fmin(val - tmp, 0x1.fffffep-1f);
-	return isnan(val) ? val : tmp;
+	return VC4CL_CHECK_NAN(val) ? val : tmp;
 })
 
 COMPLEX_2(float, fract, float, val, __private float, *iptr, {
@@ -687,7 +1066,73 @@ COMPLEX_2(float, fract, float, val, __private float, *iptr, {
 	result_t tmp = floor(val);
 	*iptr = tmp;
 	tmp = fmin(val - tmp, 0x1.fffffep-1f);
-	return isnan(val) ? val : tmp;
+	return VC4CL_CHECK_NAN(val) ? val : tmp;
+})
+
+/*
+ * Exponent-field primitives for frexp, ilogb, ldexp and logb, working on the bits of the floating-point values.
+ *
+ * Subnormal values are fully supported, since they can occur as input (e.g. read from memory) even though the
+ * hardware flushes them to zero in floating-point arithmetic.
+ */
+
+/*
+ * Returns the unbiased exponent of the floating-point value (given as bits), i.e. the exponent of its leading
+ * mantissa bit for subnormal values. The result is undefined for zero, Inf and NaN.
+ */
+COMPLEX_1(int, vc4cl_extract_exponent, int, bits, {
+	result_t exponent = ((bits >> 23) & 0xFF) - 127;
+	result_t subnormalExponent = -118 - vc4cl_clz(bits & (result_t) 0x007FFFFF);
+	return exponent == -127 ? subnormalExponent : exponent;
+})
+
+/*
+ * Returns the sign and the mantissa bits (without the implied leading one) of the floating-point value (given as
+ * bits) with a cleared exponent field. Subnormal mantissas are shifted to have their leading bit implied.
+ */
+COMPLEX_1(int, vc4cl_extract_mantissa, int, bits, {
+	result_t mantissa = bits & (result_t) 0x007FFFFF;
+	result_t shift = ((bits >> 23) & 0xFF) == 0 ? vc4cl_clz(mantissa) - 8 : (result_t) 0;
+	return (bits & (result_t) 0x80000000) | ((mantissa << shift) & (result_t) 0x007FFFFF);
+})
+
+/*
+ * Inserts the unbiased exponent in [-126, 127] into the sign and mantissa bits, see vc4cl_extract_mantissa.
+ */
+SIMPLE_2(int, vc4cl_insert_exponent, int, mantissa, int, exponent, mantissa | ((exponent + 127) << 23))
+
+/*
+ * Multiplies the floating-point value (given as bits) by 2^k by adjusting its exponent.
+ *
+ * Results above FLT_MAX return Inf, results below FLT_MIN are rounded to the nearest (even) subnormal value.
+ * Zero, Inf and NaN are returned unchanged.
+ */
+COMPLEX_2(int, vc4cl_scale_exponent, int, bits, int, k, {
+	// clamp the scale to not overflow, the result for larger values is Inf or zero anyway
+	result_t exponent = vc4cl_extract_exponent(bits) + clamp(k, -512, 512);
+	result_t mantissa = vc4cl_extract_mantissa(bits);
+	result_t sign = bits & (result_t) 0x80000000;
+	result_t normal = vc4cl_insert_exponent(mantissa, clamp(exponent, -126, 127));
+	// subnormal result: shift the full significand right and round the shifted-out bits to even
+	result_t shift = clamp(-126 - exponent, 0, 25);
+	result_t significand = (mantissa & (result_t) 0x007FFFFF) | (result_t) 0x00800000;
+	result_t half = ((result_t) 1 << shift) >> 1;
+	result_t lastDigit = (significand >> shift) & 1;
+	result_t subnormal = sign | ((significand + half - 1 + lastDigit) >> shift);
+	result_t result = exponent > 127 ? (sign | (result_t) 0x7F800000) : (exponent < -126 ? subnormal : normal);
+	int_t isSpecial = (bits & (result_t) 0x7FFFFFFF) == 0 || ((bits >> 23) & 0xFF) == 0xFF;
+	return isSpecial ? bits : result;
+})
+
+/*
+ * Calculates frexp(x) and stores the exponent in the output parameter, see frexp.
+ */
+COMPLEX_2(float, vc4cl_frexp, float, x, __private int, *exp, {
+	int_t bits = vc4cl_bitcast_int(x);
+	int_t specialCase = vc4cl_is_zero(x) || VC4CL_CHECK_INF_NAN(x);
+	// the fraction is in [0.5, 1), so the exponent is one larger than the exponent of the value
+	*exp = specialCase ? (int_t) 0 : vc4cl_extract_exponent(bits) + 1;
+	return specialCase ? x : vc4cl_bitcast_float(vc4cl_insert_exponent(vc4cl_extract_mantissa(bits), (int_t) -1));
 })
 
 /**
@@ -698,59 +1143,32 @@ COMPLEX_2(float, fract, float, val, __private float, *iptr, {
  * frexp(NaN, exp) = NaN, exp = 0
  */
 COMPLEX_2(float, frexp, float, x, __global int, *exp, {
-	// Adapted from https://git.musl-libc.org/cgit/musl/tree/src/math/frexpf.c
-	int_t absBits = vc4cl_bitcast_int(x) & (int_t)0x7FFFFFFF;
-	int_t exponent = ((absBits >> 23) & 0xFF) - 126;
-	// we need to support subnormals here, since they are only used as input, not output
-	int_t mantissa = absBits & (int_t) 0x007FFFFF;
-	int_t subnormalExpOffset = (vc4cl_clz(mantissa) - (32 - 23));
-	// the next lines are required to fix-up the mantissa for our added subnormal exponent
-	int_t subnormalExpOffsetLog2 = 33 - vc4cl_clz(subnormalExpOffset);
-	mantissa = mantissa << (exponent == -126 ? subnormalExpOffsetLog2 : 0);
-	exponent = exponent == -126 ? -subnormalExpOffset  - 126 : exponent;
-	/* mask off exponent and replace with exponent for range [0.5, 1) */
-	int_t tmp = mantissa | (int_t)0x3F000000;
-	int_t specialCase = vc4cl_is_zero(x) || vc4cl_is_inf_nan(x);
-	*exp = specialCase ? (int_t)0 : exponent;
-	return specialCase ? x : copysign(vc4cl_bitcast_float(tmp), x);
+	int_t e;
+	result_t result = vc4cl_frexp(x, &e);
+	*exp = e;
+	return result;
 })
-
 COMPLEX_2(float, frexp, float, x, __local int, *exp, {
-	// Adapted from https://git.musl-libc.org/cgit/musl/tree/src/math/frexpf.c
-	int_t absBits = vc4cl_bitcast_int(x) & (int_t)0x7FFFFFFF;
-	int_t exponent = ((absBits >> 23) & 0xFF) - 126;
-	// we need to support subnormals here, since they are only used as input, not output
-	int_t mantissa = absBits & (int_t) 0x007FFFFF;
-	int_t subnormalExpOffset = (vc4cl_clz(mantissa) - (32 - 23));
-	// the next lines are required to fix-up the mantissa for our added subnormal exponent
-	int_t subnormalExpOffsetLog2 = 33 - vc4cl_clz(subnormalExpOffset);
-	mantissa = mantissa << (exponent == -126 ? subnormalExpOffsetLog2 : 0);
-	exponent = exponent == -126 ? -subnormalExpOffset  - 126 : exponent;
-	/* mask off exponent and replace with exponent for range [0.5, 1) */
-	int_t tmp = mantissa | (int_t)0x3F000000;
-	int_t specialCase = vc4cl_is_zero(x) || vc4cl_is_inf_nan(x);
-	*exp = specialCase ? (int_t)0 : exponent;
-	return specialCase ? x : copysign(vc4cl_bitcast_float(tmp), x);
+	int_t e;
+	result_t result = vc4cl_frexp(x, &e);
+	*exp = e;
+	return result;
 })
-
 COMPLEX_2(float, frexp, float, x, __private int, *exp, {
-	// Adapted from https://git.musl-libc.org/cgit/musl/tree/src/math/frexpf.c
-	int_t absBits = vc4cl_bitcast_int(x) & (int_t)0x7FFFFFFF;
-	int_t exponent = ((absBits >> 23) & 0xFF) - 126;
-	// we need to support subnormals here, since they are only used as input, not output
-	int_t mantissa = absBits & (int_t) 0x007FFFFF;
-	int_t subnormalExpOffset = (vc4cl_clz(mantissa) - (32 - 23));
-	// the next lines are required to fix-up the mantissa for our added subnormal exponent
-	int_t subnormalExpOffsetLog2 = 33 - vc4cl_clz(subnormalExpOffset);
-	mantissa = mantissa << (exponent == -126 ? subnormalExpOffsetLog2 : 0);
-	exponent = exponent == -126 ? -subnormalExpOffset  - 126 : exponent;
-	/* mask off exponent and replace with exponent for range [0.5, 1) */
-	int_t tmp = mantissa | (int_t)0x3F000000;
-	int_t specialCase = vc4cl_is_zero(x) || vc4cl_is_inf_nan(x);
-	*exp = specialCase ? (int_t)0 : exponent;
-	return specialCase ? x : copysign(vc4cl_bitcast_float(tmp), x);
+	int_t e;
+	result_t result = vc4cl_frexp(x, &e);
+	*exp = e;
+	return result;
 })
 
+/*
+ * Returns the exponent of the given magnitude clamped to [-126, 126].
+ *
+ * Multiplying by 2^-e scales the magnitude (and all smaller values) into [1, 4), where squares and sums of squares
+ * neither overflow nor underflow, see hypot and length.
+ */
+SIMPLE_1(int, vc4cl_square_scale_exponent, float, val, clamp(((vc4cl_bitcast_int(val) >> 23) & 0xFF) - 127, -126, 126))
+
 /**
  * Expected behavior:
  *
@@ -758,7 +1176,15 @@ COMPLEX_2(float, frexp, float, x, __private int, *exp, {
  * hypot(x, +-0) = fabs(x)
  * hypot(+-Inf, y) = +Inf
  */
-SIMPLE_2(float, hypot, float, x, float, y, sqrt(x *x + y * y))
+COMPLEX_2(float, hypot, float, x, float, y, {
+	// scale both values by the exponent of the larger magnitude, so the squares can neither overflow nor underflow
+	int_t exponent = vc4cl_square_scale_exponent(vc4cl_fmaxabs(x, y));
+	result_t scale = vc4cl_pow2(-exponent);
+	result_t scaledX = x * scale;
+	result_t scaledY = y * scale;
+	result_t result = sqrt(scaledX * scaledX + scaledY * scaledY) * vc4cl_pow2(exponent);
+	return VC4CL_CHECK_INF(x) || VC4CL_CHECK_INF(y) ? (result_t) INFINITY : result;
+})
 
 /**
  * Expected behavior (C99 standard):
@@ -769,16 +1195,10 @@ SIMPLE_2(float, hypot, float, x, float, y, sqrt(x *x + y * y))
  */
 COMPLEX_1(int, ilogb, float, x, {
 	//"Return the exponent as an integer value."
-	// https://en.wikipedia.org/wiki/Single-precision_floating-point_format
-	result_t bitcast = vc4cl_bitcast_int(x);
-	// deduct exponent offset
-	int_t result = ((bitcast >> 23) & 0xFF) - 127;
-	// we need to support subnormals here, since they are only used as input, not output
-	int_t mantissa = bitcast & (int_t) 0x007FFFFF;
-	result = result == -127 ? -(vc4cl_clz(mantissa) - (32 - 23)) - 127 : result;
+	result_t result = vc4cl_extract_exponent(vc4cl_bitcast_int(x));
 	result = vc4cl_is_zero(x) ? (result_t)FP_ILOGB0 : result;
-	result = isinf(x) ? (result_t)INT_MAX : result;
-	return isnan(x) ? (result_t)FP_ILOGBNAN : result;
+	result = VC4CL_CHECK_INF(x) ? (result_t)INT_MAX : result;
+	return VC4CL_CHECK_NAN(x) ? (result_t)FP_ILOGBNAN : result;
 })
 
 /**
@@ -790,15 +1210,176 @@ COMPLEX_1(int, ilogb, float, x, {
  */
 //"Multiply x by 2 to the power k."
 COMPLEX_2(float, ldexp, float, x, int, k, {
-	// Taken from MESA (https://gitlab.freedesktop.org/mesa/mesa/-/blob/master/src/compiler/nir/nir_opt_algebraic.py)
-	// Alternatively in https://git.musl-libc.org/cgit/musl/tree/src/math/scalbnf.c
-	int_t exp = min(max(k, -254), 254);
-	int_t pow2_1 = ((exp >> 1) + 127) << 23;
-	int_t pow2_2 = ((exp - (exp >> 1)) + 127) << 23;
-	result_t result = x * vc4cl_bitcast_float(pow2_1) * vc4cl_bitcast_float(pow2_2);
-	return vc4cl_is_inf_nan(x) ? x : result;
+	return vc4cl_bitcast_float(vc4cl_scale_exponent(vc4cl_bitcast_int(x), k));
+})
+COMPLEX_2_SCALAR(float, ldexp, float, x, int, k, {
+	return ldexp(x, (int_t) k);
+})
+
+/*
+ * Returns log2(c) in extended precision for the center c of the interval with the given index in [0, 7] (see
+ * vc4cl_log2_extended) and stores 1 / c in the output parameter.
+ *
+ * Since there is no efficient way to index into a constant table with vector indices, the table lookup is implemented
+ * as tree of selections on the bits of the index.
+ */
+COMPLEX_2(FloatFloat, vc4cl_log2_table, int, index, __private float, *reciprocal, {
+	int_t bit0 = (index & 1) != 0;
+	int_t bit1 = (index & 2) != 0;
+	int_t bit2 = (index & 4) != 0;
+	float_t recip0 = bit0 ? (float_t) 0x1.3b13b2p+0f : (float_t) 0x1.555556p+0f;
+	float_t recip1 = bit0 ? (float_t) 0x1.111112p+0f : (float_t) 0x1.24924ap+0f;
+	float_t recip2 = bit0 ? (float_t) 0x1.c71c72p-1f : (float_t) 0x1.0p+0f;
+	float_t recip3 = bit0 ? (float_t) 0x1.745d18p-1f : (float_t) 0x1.99999ap-1f;
+	float_t upper0 = bit0 ? (float_t) -0x1.32bfeep-2f : (float_t) -0x1.a8ff98p-2f;
+	float_t upper1 = bit0 ? (float_t) -0x1.7d604ap-4f : (float_t) -0x1.8a8980p-3f;
+	float_t upper2 = bit0 ? (float_t) 0x1.5c01a4p-3f : (float_t) 0.0f;
+	float_t upper3 = bit0 ? (float_t) 0x1.d6753ep-2f : (float_t) 0x1.49a784p-2f;
+	float_t lower0 = bit0 ? (float_t) -0x1.b87734p-29f : (float_t) 0x1.cfdeb4p-27f;
+	float_t lower1 = bit0 ? (float_t) 0x1.260896p-29f : (float_t) -0x1.57f7a6p-28f;
+	float_t lower2 = bit0 ? (float_t) -0x1.810a5ep-29f : (float_t) 0.0f;
+	float_t lower3 = bit0 ? (float_t) 0x1.975078p-33f : (float_t) 0x1.79a372p-27f;
+	recip0 = bit1 ? recip1 : recip0;
+	recip2 = bit1 ? recip3 : recip2;
+	upper0 = bit1 ? upper1 : upper0;
+	upper2 = bit1 ? upper3 : upper2;
+	lower0 = bit1 ? lower1 : lower0;
+	lower2 = bit1 ? lower3 : lower2;
+	*reciprocal = bit2 ? recip2 : recip0;
+	return vc4cl_combine(bit2 ? upper2 : upper0, bit2 ? lower2 : lower0);
+})
+
+/*
+ * Calculates log2(x) for positive finite (normal) values and returns the result in extended precision.
+ *
+ * Range reduction: x = 2^k * z with z in [0x1.7p-1, 0x1.7p+0), which is split into 8 intervals by the upper mantissa
+ * bits of z. With the center c of the interval, this gives log2(x) = k + log2(c) + log2(1 + r) with r = (z - c) / c and
+ * |r| < 1/16. log2(c) is read from a table in extended precision. The intervals are chosen so that c = 1 for the
+ * interval containing 1, so the result has no cancellation for values close to 1.
+ *
+ * z - c is exact and c has only 4 significant bits, so the rounding error of the division can be calculated exactly
+ * and is added as correction term. log2(1 + r) is calculated as r * log2(e) in extended precision plus r^2 * P(r),
+ * where P is a minimax polynomial of degree 4 (relative error of the sum < 2^-31).
+ *
+ * The result is not rounded, which allows e.g. log and log10 to multiply with a constant in extended precision and pow
+ * to use the full precision of the logarithm.
+ *
+ * Max error of the upper part (tested on host): 1 ULP for log2, log, log10 and log1p
+ *
+ * NOTE: Special values (zero, negative values, Inf and NaN) are not handled and need to be checked by the caller!
+ */
+COMPLEX_1(FloatFloat, vc4cl_log2_extended, float, val, {
+	int_t bits = vc4cl_bitcast_int(val);
+	int_t offset = bits - (int_t) 0x3F380000;
+	int_t exponent = offset >> 23;
+	// z = x * 2^-k and the center of the interval (the index bits of z with the following bit set)
+	float_t z = vc4cl_bitcast_float(bits - (offset & (int_t) 0xFF800000));
+	float_t center = vc4cl_bitcast_float((int_t) 0x3F380000 + (offset & (int_t) 0x00700000) + (int_t) 0x00080000);
+	float_t reciprocal;
+	result_t table = vc4cl_log2_table((offset >> 20) & 7, &reciprocal);
+	// z - c is exact, since both are within a factor of 2
+	float_t diff = z - center;
+	float_t r = diff * reciprocal;
+	// the upper 19 bits of r times c (4 bits) are exact, as is the lower part of r times c
+	float_t rUpper = vc4cl_bitcast_float(vc4cl_bitcast_uint(r) & 0xFFFFFFE0);
+	float_t rError = ((diff - rUpper * center) - (r - rUpper) * center) * reciprocal;
+	float_t poly = r * r *
+		(-7.2134751081e-01f +
+			r * (4.8089733720e-01f + r * (-3.6068871617e-01f + r * (2.8950372338e-01f + r * -2.3663182557e-01f))));
+	result_t product = vc4cl_mul(r, vc4cl_upper(M_LOG2E_FF));
+	float_t tail = vc4cl_lower(product) +
+		(r * vc4cl_lower(M_LOG2E_FF) + rError * vc4cl_upper(M_LOG2E_FF) + poly);
+	// fast two-sum, since either k = 0 or |k| >= 1 > |log2(c)|
+	float_t k = vc4cl_itof(exponent);
+	float_t sum = k + vc4cl_upper(table);
+	float_t error = vc4cl_upper(table) - (sum - k);
+	return vc4cl_add(vc4cl_combine(sum, error + vc4cl_lower(table)), vc4cl_add(vc4cl_upper(product), tail));
+})
+
+/*
+ * Calculates log2(gamma(x)) for x >= 0.5 in extended precision. For the reflection, the argument has a lower part.
+ *
+ * Uses the Lanczos approximation with g = 3.5 and n = 5 (relative error < 2^-26, tested on host, the maximum is at
+ * x = 0.5):
+ * gamma(x) = (x + g - 0.5)^(x - 0.5) * e^-(x + g - 0.5) * sqrt(2 * pi) * A(x)
+ * The (partial fraction) sum A(x) times sqrt(2 * pi) is evaluated as rational function with positive coefficients in
+ * 1/x, which neither overflows for large x nor suffers from cancellation.
+ *
+ * log2(gamma(x)) = (x - 0.5) * log2(t) - t * log2(e) + log2(sqrt(2 * pi) * A(x)) with t = x + 3 is calculated in
+ * extended precision, since the error is magnified by the magnitude of the result (e.g. for tgamma).
+ *
+ * See also:
+ * https://en.wikipedia.org/wiki/Lanczos_approximation
+ * https://www.boost.org/doc/libs/1_73_0/libs/math/doc/html/math_toolkit/lanczos.html
+ */
+COMPLEX_1(FloatFloat, vc4cl_log2_gamma_positive, FloatFloat, val, {
+	float_t x = vc4cl_upper(val);
+	float_t z = 1.0f / x;
+	float_t numerator = ((((8.3494006348e+02f * z + 1.3143393555e+03f) * z + 8.2538769531e+02f) * z +
+		2.5840029907e+02f) * z + 4.0314937592e+01f) * z + 2.5066282749e+00f;
+	float_t denominator = (((24.0f * z + 50.0f) * z + 35.0f) * z + 10.0f) * z + 1.0f;
+	result_t t = vc4cl_add(x, (float_t) 3.0f);
+	t = vc4cl_combine(vc4cl_upper(t), vc4cl_lower(t) + vc4cl_lower(val));
+	result_t offset = vc4cl_add(x, (float_t) -0.5f);
+	offset = vc4cl_combine(vc4cl_upper(offset), vc4cl_lower(offset) + vc4cl_lower(val));
+	// log2(upper + lower) ~ log2(upper) + lower / upper * log2(e)
+	result_t logT = vc4cl_log2_extended(vc4cl_upper(t));
+	logT = vc4cl_combine(vc4cl_upper(logT),
+		vc4cl_lower(logT) + vc4cl_lower(t) / vc4cl_upper(t) * vc4cl_upper(M_LOG2E_FF));
+	result_t result = vc4cl_add(vc4cl_sub(vc4cl_mul(offset, logT), vc4cl_mul(t, M_LOG2E_FF)),
+		vc4cl_log2_extended(numerator / denominator));
+	// the extended precision products overflow for very large x, where the result is rounded to the upper part anyway
+	float_t large = x * vc4cl_upper(logT) - x * M_LOG2E_F;
+	int_t isLarge = x > 0x1.0p64f;
+	// select the parts separately, since the condition for 64-bit values would need to be 64-bit too
+	return vc4cl_combine(isLarge ? large : vc4cl_upper(result), isLarge ? (float_t) 0.0f : vc4cl_lower(result));
+})
+
+/*
+ * Calculates log2(|gamma(x)|) in extended precision and stores the sign of gamma(x) in the output parameter.
+ *
+ * For x < 0.5, the reflection formula gamma(x) = pi / (sin(pi * x) * gamma(1 - x)) is applied, where 1 - x is
+ * calculated exactly. Since gamma(1 - x) is positive, the sign of the result is the sign of sin(pi * x).
+ * The reflection is only calculated if any element of the vector requires it.
+ *
+ * Max error (tested on host): 7 ULP for tgamma
+ *
+ * NOTE: The poles (x <= 0 and x integer), Inf and NaN are not handled and need to be checked by the caller!
+ */
+COMPLEX_2(FloatFloat, vc4cl_log2_gamma, float, val, __private int, *sign, {
+	int_t reflect = val < 0.5f;
+	result_t reflected = vc4cl_add((float_t) 1.0f, -val);
+	result_t result = vc4cl_log2_gamma_positive(vc4cl_combine(reflect ? vc4cl_upper(reflected) : val,
+		reflect ? vc4cl_lower(reflected) : (float_t) 0.0f));
+	int_t s = 1;
+	// any() checks the MSB, which is not set for the scalar comparison result, so check the sign of val - 0.5 instead
+	if(any(vc4cl_bitcast_int(val - 0.5f)))
+	{
+		float_t sine = sinpi(val);
+		result_t reflectedResult = vc4cl_sub(vc4cl_sub(M_LOG2_PI_FF, vc4cl_log2_extended(fabs(sine))), result);
+		// select the parts separately, since the condition for 64-bit values would need to be 64-bit too
+		result = vc4cl_combine(reflect ? vc4cl_upper(reflectedResult) : vc4cl_upper(result),
+			reflect ? vc4cl_lower(reflectedResult) : vc4cl_lower(result));
+		s = reflect && sine < 0.0f ? (int_t) -1 : (int_t) 1;
+	}
+	*sign = s;
+	return result;
+})
+
+/*
+ * Calculates lgamma(x) and stores the sign of gamma(x) in the output parameter, see lgamma and lgamma_r.
+ */
+COMPLEX_2(float, vc4cl_lgamma, float, val, __private int, *signp, {
+	int_t sign;
+	result_t result = vc4cl_upper(vc4cl_mul(vc4cl_log2_gamma(val, &sign), M_LN2_FF));
+	result = val == 1.0f || val == 2.0f ? (result_t) 0.0f : result;
+	// gamma(+-0) = +-Inf, the sign for the other poles is not defined
+	int_t isPole = val <= 0.0f && trunc(val) == val;
+	sign = vc4cl_is_zero(val) ? (signbit(val) ? (int_t) -1 : (int_t) 1) : (isPole ? (int_t) 0 : sign);
+	result = isPole || VC4CL_CHECK_INF(val) ? (result_t) INFINITY : result;
+	*signp = VC4CL_CHECK_NAN(val) ? (int_t) 0 : sign;
+	return VC4CL_CHECK_NAN(val) ? val : result;
 })
-SIMPLE_2_SCALAR(float, ldexp, float, x, int, k, x *(k >= 0 ? vc4cl_itof(1 << k) : 1.0f / vc4cl_itof(1 << -k)))
 
 /**
  * Expected behavior:
@@ -811,83 +1392,60 @@ SIMPLE_2_SCALAR(float, ldexp, float, x, int, k, x *(k >= 0 ? vc4cl_itof(1 << k)
  */
 COMPLEX_1(float, lgamma, float, val, {
 	//"Returns the natural logarithm of the absolute value of the gamma function"
-	// see Numerical Recipes, chapter 6.1
-	// has error of < 2 * 10^-10
-
-	// XXX only for val > 0
-	// TODO far too inaccurate/wrong?
-	result_t x;
-	result_t y;
-	result_t tmp;
-	result_t ser;
-
-	y = x = val;
-	tmp = x + 5.5f;
-	tmp -= (x + 0.5f) * log(tmp);
-	ser = 1.000000000190015f;
-	y += 1;
-	ser += 76.18009172947146f / y;
-	y += 1;
-	ser += -86.50532032941677f / y;
-	y += 1;
-	ser += 24.01409824083091f / y;
-	y += 1;
-	ser += -1.231739572450155f / y;
-	y += 1;
-	ser += 0.1208650973866179e-2f / y;
-	y += 1;
-	ser += -0.5395239384953e-5f / y;
-	return -tmp + log((2.5066282746310005f) * ser / x);
+	int_t sign;
+	return vc4cl_lgamma(val, &sign);
 })
 
 /**
  * Expected behavior:
  *
- * lgamma_r(x, signp) -> signp = 0 for x < 0
+ * lgamma_r(x, signp) -> signp = 0 for x < 0 and x integer
  */
 COMPLEX_2(float, lgamma_r, float, x, __global int, *signp, {
-	// TODO better way?
-	result_t tmp = lgamma(x);
-	*signp = tmp < 0.0f ? -1 : (tmp == 0.0f) ? 0 : 1;
-	return lgamma(x < 0.0f ? (-1.0f * x) : x);
+	int_t sign;
+	result_t result = vc4cl_lgamma(x, &sign);
+	*signp = sign;
+	return result;
 })
 COMPLEX_2(float, lgamma_r, float, x, __local int, *signp, {
-	// TODO better way?
-	result_t tmp = lgamma(x);
-	*signp = tmp < 0.0f ? -1 : (tmp == 0.0f) ? 0 : 1;
-	return lgamma(x < 0.0f ? (-1.0f * x) : x);
+	int_t sign;
+	result_t result = vc4cl_lgamma(x, &sign);
+	*signp = sign;
+	return result;
 })
 COMPLEX_2(float, lgamma_r, float, x, __private int, *signp, {
-	// TODO better way?
-	result_t tmp = lgamma(x);
-	*signp = tmp < 0.0f ? -1 : (tmp == 0.0f) ? 0 : 1;
-	return lgamma(x < 0.0f ? (-1.0f * x) : x);
+	int_t sign;
+	result_t result = vc4cl_lgamma(x, &sign);
+	*signp = sign;
+	return result;
 })
 
-COMPLEX_1(float, log1p_pade, float, val, {
-	/*
-	 * Calculates ln(1 + x) via Pade approximation
-	 * (https://ir.canterbury.ac.nz/bitstream/handle/10092/8886/brookes_thesis.pdf?sequence=1, page 72/96)
-	 *
-	 * Has a relative error of less than 2*2^23 (2 ULP) for range [-0.5, 2], then rises fast
-	 */
-	// g(x) = (49x^6+1218x^5+7980x^4+20720x^3+23100x^2+9240x)/(10x^6+420x^5+4200x^4+16800x^3+31500x^2+27720x+9240)
-	arg_t a = 49.0f * val * val * val * val * val * val;
-	arg_t b = 1218.0f * val * val * val * val * val;
-	arg_t c = 7980.0f * val * val * val * val;
-	arg_t d = 20720.0f * val * val * val;
-	arg_t e = 23100.0f * val * val;
-	arg_t f = 9240.0f * val;
-	arg_t g = 10.0f * val * val * val * val * val * val;
-	arg_t h = 420.0f * val * val * val * val * val;
-	arg_t i = 4200.0f * val * val * val * val;
-	arg_t k = 16800.0f * val * val * val;
-	arg_t l = 31500.0f * val * val;
-	arg_t m = 27720.0f * val;
-	arg_t n = 9240.0f;
-	arg_t up = a + b + c + d + e + f;
-	arg_t down = g + h + i + k + l + m + n;
-	return up / down;
+/*
+ * Calculates log(x) in single precision for the faster accuracy tier of log (see VC4CL_MATH_ACCURACY).
+ *
+ * Range reduction: x = 2^k * m with m in [sqrt(2)/2, sqrt(2)), which gives log(x) = k * log(2) + log(1 + f) with
+ * f = m - 1. log(1 + f) = 2 * atanh(s) with s = f / (2 + f) is approximated as f - f^2/2 + s * (f^2/2 + R(s^2)), where R
+ * is the minimax polynomial of fdlibm (http://www.netlib.org/fdlibm/e_log.c) evaluated as two polynomials in s^4.
+ * log(2) is split into two parts, so that k * part is exact for the first part.
+ *
+ * Max error (tested on host): 1 ULP
+ *
+ * NOTE: Special values (zero, negative values, Inf and NaN) are not handled and need to be checked by the caller!
+ */
+COMPLEX_1(float, vc4cl_log_fast, float, val, {
+	int_t bits = vc4cl_bitcast_int(val);
+	int_t mantissa = vc4cl_extract_mantissa(bits);
+	int_t exponent = vc4cl_extract_exponent(bits);
+	// mantissas above sqrt(2) are moved into [sqrt(2)/2, 1) by decrementing the exponent of m
+	int_t isLarge = mantissa > (int_t) 0x003504F3;
+	arg_t k = vc4cl_itof(isLarge ? exponent + 1 : exponent);
+	arg_t f = vc4cl_bitcast_float(mantissa | (isLarge ? (int_t) 0x3F000000 : (int_t) 0x3F800000)) - 1.0f;
+	arg_t s = f / (2.0f + f);
+	arg_t z = s * s;
+	arg_t w = z * z;
+	arg_t r = z * (6.6666662693e-01f + w * 2.8498786688e-01f) + w * (4.0000972152e-01f + w * 2.4279078841e-01f);
+	arg_t halfSquare = 0.5f * f * f;
+	return k * 6.9313812256e-01f - ((halfSquare - (s * (halfSquare + r) + k * 9.0580006145e-06f)) - f);
 })
 
 /**
@@ -898,39 +1456,15 @@ COMPLEX_1(float, log1p_pade, float, val, {
  * log2(x) = Nan for x < 0
  * log2(+Inf) = +Inf
  */
+#ifndef VC4CL_RELAXED_MATH
 COMPLEX_1(float, log2, float, val, {
-
-	/* log2(x) = log2(M * e^E) = E + log2(M) */
-	int_t bitcast = vc4cl_bitcast_int(val);
-	/* deduct exponent offset, we use -126 instead of -127, since we go into the range [0.5, 1), not [1, 2) */
-	int_t exponent = ((bitcast >> 23) & 0xFF) - 126;
-
-	/* mask off exponent and replace with exponent for range [0.5, 1) */
-	int_t tmp = (bitcast & (int_t)0x807FFFFF) | (int_t)0x3F000000;
-	arg_t mantissa = vc4cl_bitcast_float(tmp);
-
-	/*
-	 * Alternatively could use SFU and Newton-Raphson steps:
-	 * f(x) = log2(x) - y
-	 * root: f(x) = 0 -> log2(x) = y
-	 * f'(x) = 1/(x * ln(2))
-	 * xn+1 = xn - (log2(xn) - y) / (1/(xn * ln(2)))
-	 * xn+1 = xn - xn * ln(2) * (log2(x) - y)
-	 * => but don't know y which is exact log2(x)!!!
-	 *
-	 * Alternatively could approximate root of: f(y) = 2^y - x, need exact exp2(x)
-	 */
-	// result_t logMantissa = vc4cl_sfu_log2(mantissa);
-
-	// log2(M*2^E) = E + log2(M) = E + ln(M) / ln(2) = E + ln1p(M - 1) / ln(2)
-	result_t logMantissa = log1p_pade(mantissa - 1.0f) / M_LN2_F;
-
-	result_t result = vc4cl_itof(exponent) + logMantissa;
-	result = vc4cl_is_inf_nan(val) ? val : result;
+	result_t result = vc4cl_upper(vc4cl_log2_extended(val));
+	result = VC4CL_CHECK_INF_NAN(val) ? val : result;
 	result = signbit(val) ? (result_t)nan(0) : result;
 	result = vc4cl_is_zero(val) ? (result_t)-INFINITY: result;
 	return result;
 })
+#endif
 
 /**
  * Expected behavior:
@@ -940,6 +1474,17 @@ COMPLEX_1(float, log2, float, val, {
  * log(x) = Nan for x < 0
  * log(+Inf) = +Inf
  */
+#if VC4CL_ALLOWS_ULP(8192)
+SIMPLE_1(float, log, float, val, native_log(val))
+#elif VC4CL_ALLOWS_ULP(1)
+COMPLEX_1(float, log, float, val, {
+	result_t result = vc4cl_log_fast(val);
+	result = VC4CL_CHECK_INF_NAN(val) ? val : result;
+	result = signbit(val) ? (result_t)nan(0) : result;
+	result = vc4cl_is_zero(val) ? (result_t)-INFINITY: result;
+	return result;
+})
+#else
 COMPLEX_1(float, log, float, val, {
 	/*
 	 * Other sources/calculations:
@@ -953,23 +1498,14 @@ COMPLEX_1(float, log, float, val, {
 	 * - https://stackoverflow.com/questions/39821367/very-fast-approximate-logarithm-natural-log-function-in-c
 	 */
 
-	/* log(M * 2^E) = log(M) + E log(2) */
-	int_t bitcast = vc4cl_bitcast_int(val);
-	/* deduct exponent offset, we use -126 instead of -127, since we go into the range [0.5, 1), not [1, 2) */
-	int_t exponent = ((bitcast >> 23) & 0xFF) - 126;
-
-	/* mask off exponent and replace with exponent for range [0.5, 1) */
-	int_t tmp = (bitcast & (int_t)0x807FFFFF) | (int_t)0x3F000000;
-	arg_t mantissa = vc4cl_bitcast_float(tmp);
-
-	result_t logMantissa = log1p_pade(mantissa - 1.0f);
-
-	result_t result = vc4cl_itof(exponent) * M_LN2_F + logMantissa;
-	result = vc4cl_is_inf_nan(val) ? val : result;
+	// log(x) = log2(x) * log(2)
+	result_t result = vc4cl_upper(vc4cl_mul(vc4cl_log2_extended(val), M_LN2_FF));
+	result = VC4CL_CHECK_INF_NAN(val) ? val : result;
 	result = signbit(val) ? (result_t)nan(0) : result;
 	result = vc4cl_is_zero(val) ? (result_t)-INFINITY: result;
 	return result;
 })
+#endif
 
 /**
  * Expected behavior:
@@ -979,26 +1515,16 @@ COMPLEX_1(float, log, float, val, {
  * log10(x) = Nan for x < 0
  * log10(+Inf) = +Inf
  */
+#ifndef VC4CL_RELAXED_MATH
 COMPLEX_1(float, log10, float, val, {
-	/* log10(M * 2^E) = log10(M) + E log10(2) */
-	int_t bitcast = vc4cl_bitcast_int(val);
-	/* deduct exponent offset, we use -126 instead of -127, since we go into the range [0.5, 1), not [1, 2) */
-	int_t exponent = ((bitcast >> 23) & 0xFF) - 126;
-
-	/* mask off exponent and replace with exponent for range [0.5, 1) */
-	int_t tmp = (bitcast & (int_t)0x807FFFFF) | (int_t)0x3F000000;
-	arg_t mantissa = vc4cl_bitcast_float(tmp);
-
-	/* log10(M) = log(M) / log(10) */
-	result_t logMantissa = log1p_pade(mantissa - 1.0f) / M_LN10_F;
-
-	const arg_t log2_10 = M_LN2_F / M_LN10_F;
-	result_t result = vc4cl_itof(exponent) * log2_10 + logMantissa;
-	result = vc4cl_is_inf_nan(val) ? val : result;
+	// log10(x) = log2(x) * log10(2)
+	result_t result = vc4cl_upper(vc4cl_mul(vc4cl_log2_extended(val), M_LOG10_2_FF));
+	result = VC4CL_CHECK_INF_NAN(val) ? val : result;
 	result = signbit(val) ? (result_t)nan(0) : result;
 	result = vc4cl_is_zero(val) ? (result_t)-INFINITY: result;
 	return result;
 })
+#endif
 
 /**
  * Expected behavior:
@@ -1008,17 +1534,51 @@ COMPLEX_1(float, log10, float, val, {
  * log1p(x) = Nan for x < -1
  * log1p(+Inf) = +Inf
  */
-//TODO directly use log1p_pade(), needs argument reduction
 COMPLEX_1(float, log1p, float, val, {
-	result_t result = log(1.0f + val);
+	// 1 + x = upper + lower is calculated exactly (two-sum), which gives log(1 + x) ~ log(upper) + lower / upper.
+	// For small x, log(upper) is calculated without cancellation, since the reduction of the logarithm is exact around 1
+	arg_t upper = 1.0f + val;
+	arg_t tmp = upper - 1.0f;
+	arg_t lower = (1.0f - (upper - tmp)) + (val - tmp);
+	result_t result = vc4cl_lossy(vc4cl_mul(vc4cl_log2_extended(upper), M_LN2_FF)) + lower / upper;
 
 	result = vc4cl_is_zero(val) ? val : result;
 	result = val == (arg_t)-1.0f ? (result_t)-INFINITY : result;
 	result = val < (arg_t)-1.0f ? (result_t)nan(0) : result;
-	result = vc4cl_is_inf_nan(val) ? val : result;
+	result = VC4CL_CHECK_INF_NAN(val) ? val : result;
 	return result;
 })
 
+/*
+ * Calculates the exponent y * log2(x) of the exponentiation functions in extended precision from the unrounded
+ * logarithm.
+ *
+ * Unlike the extended precision multiplication, the upper part is the rounded product even for infinite or very large
+ * y, in which case vc4cl_exp2_extended ignores the (invalid) lower part.
+ *
+ * NOTE: Special values of x (see vc4cl_log2_extended) and x = 1 for very large y need to be checked by the caller!
+ */
+COMPLEX_2(FloatFloat, vc4cl_pow_exponent, float, x, float, y, {
+	result_t logarithm = vc4cl_log2_extended(x);
+	result_t product = vc4cl_mul(y, vc4cl_upper(logarithm));
+	return vc4cl_combine(vc4cl_upper(product), vc4cl_lower(product) + y * vc4cl_lower(logarithm));
+})
+
+/*
+ * Calculates x^y for finite x > 0, see pow and powr.
+ *
+ * By default, x^y = 2^(y * log2(x)) with the exponent in extended precision, since its error is magnified by the
+ * magnitude of the result. The faster accuracy tier (see VC4CL_MATH_ACCURACY) calculates e^(y * log(x)) in single
+ * precision, where the relative error of the exponent is magnified by up to |y * log(x)| < 104.
+ *
+ * NOTE: x = 1 for infinite y needs to be checked by the caller!
+ */
+#if VC4CL_ALLOWS_ULP(144)
+SIMPLE_2(float, vc4cl_pow_positive, float, x, float, y, vc4cl_exp_fast(y * vc4cl_log_fast(x)))
+#else
+SIMPLE_2(float, vc4cl_pow_positive, float, x, float, y, vc4cl_upper(vc4cl_exp2_extended(vc4cl_pow_exponent(x, y))))
+#endif
+
 /**
  * Expected behavior:
  *
@@ -1026,18 +1586,13 @@ COMPLEX_1(float, log1p, float, val, {
  * logb(+-Inf) = +Inf
  */
 COMPLEX_1(float, logb, float, x, {
-	int_t bitcast = vc4cl_bitcast_int(x);
-	// deduct exponent offset
-	int_t exponent = ((bitcast >> 23) & 0xFF) - 127;
-	// we need to support subnormals here, since they are only used as input, not output
-	int_t mantissa = bitcast & (int_t) 0x007FFFFF;
-	exponent = exponent == -127 ? -(vc4cl_clz(mantissa) - (32 - 23)) - 127 : exponent;
-	result_t result = vc4cl_itof(exponent);
+	result_t result = vc4cl_itof(vc4cl_extract_exponent(vc4cl_bitcast_int(x)));
 	result = vc4cl_is_zero(x) ? (result_t)-INFINITY : result;
-	result = isinf(x) ? fabs(x) : result;
-	return isnan(x) ? x : result;
+	result = VC4CL_CHECK_INF(x) ? fabs(x) : result;
+	return VC4CL_CHECK_NAN(x) ? x : result;
 })
 
+// fast path for fma, the product is rounded before the addition
 SIMPLE_3(float, mad, float, a, float, b, float, c, (a * b) + c)
 
 //"Returns x if |x|>|y|, y if |y|>|x|, otherwise fmax(x, y)"
@@ -1065,21 +1620,21 @@ COMPLEX_2(float, minmag, float, x, float, y, {
 // taken OpenCL C 1.2 specification, 7.5.2. Changes to C99 TC2 Behavior
 COMPLEX_2(float, modf, float, value, __global float, *iptr, {
 	result_t tmp = trunc(value);
-	*iptr = isnan(value) ? value : tmp;
-	result_t result = copysign(isinf(value) ? (result_t)0.0f : value - tmp, value);
-	return isnan(value) ? value : result;
+	*iptr = VC4CL_CHECK_NAN(value) ? value : tmp;
+	result_t result = copysign(VC4CL_CHECK_INF(value) ? (result_t)0.0f : value - tmp, value);
+	return VC4CL_CHECK_NAN(value) ? value : result;
 })
 COMPLEX_2(float, modf, float, value, __local float, *iptr, {
 	result_t tmp = trunc(value);
-	*iptr = isnan(value) ? value : tmp;
-	result_t result = copysign(isinf(value) ? (result_t)0.0f : value - tmp, value);
-	return isnan(value) ? value : result;
+	*iptr = VC4CL_CHECK_NAN(value) ? value : tmp;
+	result_t result = copysign(VC4CL_CHECK_INF(value) ? (result_t)0.0f : value - tmp, value);
+	return VC4CL_CHECK_NAN(value) ? value : result;
 })
 COMPLEX_2(float, modf, float, value, __private float, *iptr, {
 	result_t tmp = trunc(value);
-	*iptr = isnan(value) ? value : tmp;
-	result_t result = copysign(isinf(value) ? (result_t)0.0f : value - tmp, value);
-	return isnan(value) ? value : result;
+	*iptr = VC4CL_CHECK_NAN(value) ? value : tmp;
+	result_t result = copysign(VC4CL_CHECK_INF(value) ? (result_t)0.0f : value - tmp, value);
+	return VC4CL_CHECK_NAN(value) ? value : result;
 })
 
 SIMPLE_1(float, nan, uint, nancode, vc4cl_bitcast_float(NAN | nancode))
@@ -1105,7 +1660,7 @@ COMPLEX_2(float, nextafter, float, x, float, y, {
 	result = (x == (result_t)0.0f && y < 0.0f) ? (result_t)-FLT_MIN : result;
 	result = (x == (result_t)FLT_MIN && y < (result_t)FLT_MIN) ? (result) +0.0f : result;
 	result = (x == (result_t)-FLT_MIN && y > (result_t)-FLT_MIN) ? (result) -0.0f : result;
-	return isnan(x) ? x : (isnan(y) ? y : result);
+	return VC4CL_CHECK_NAN(x) ? x : (VC4CL_CHECK_NAN(y) ? y : result);
 })
 
 /**
@@ -1119,10 +1674,10 @@ COMPLEX_2(float, nextafter, float, x, float, y, {
  * pow(1, y) = 1
  * pow(x, +-0) = 1
  * pow(x, y) = NaN for x < 0 and y not an integer
- * pow(x, -Inf) = +Inf for |x| < 0
- * pow(x, -Inf) = 0 for |x| > 0
- * pow(x, +Inf) = 0 for |x| < 0
- * pow(x, +Inf) = 0 for |x| > 0
+ * pow(x, -Inf) = +Inf for |x| < 1
+ * pow(x, -Inf) = 0 for |x| > 1
+ * pow(x, +Inf) = 0 for |x| < 1
+ * pow(x, +Inf) = +Inf for |x| > 1
  * pow(-Inf, y) = -0 for y odd and y < 0
  * pow(-Inf, y) = 0 for y even and y < 0
  * pow(-Inf, y) = -Inf for y odd and y > 0
@@ -1132,10 +1687,32 @@ COMPLEX_2(float, nextafter, float, x, float, y, {
  * pow(+-0, -Inf) =+Inf
  */
 // for pow, see also https://stackoverflow.com/questions/4518011/algorithm-for-powfloat-float
+#ifndef VC4CL_RELAXED_MATH
 COMPLEX_2(float, pow, float, x, float, y, {
-	result_t tmp = powr(x, y);
-	return y < 0.0f ? (result_t) 1.0f / tmp : tmp;
+	// |x|^y = 2^(y * log2|x|), see powr. The sign and the validity for negative x only depend on whether y is an
+	// (odd) integer, which is determined from the bits of y
+	result_t result = vc4cl_pow_positive(fabs(x), y);
+	// the logarithm does not handle x = 0 and x = Inf (with infinite logarithms)
+	result = vc4cl_is_zero(x) || VC4CL_CHECK_INF(x) ? (VC4CL_CHECK_INF(x) == (y > 0.0f) ? (result_t) INFINITY : (result_t) 0.0f) : result;
+	result = fabs(x) == 1.0f ? (result_t) 1.0f : result;
+
+	int_t yBits = vc4cl_bitcast_int(y);
+	int_t yExponent = ((yBits >> 23) & 0xFF) - 127;
+	// position of the bit with the value 1 (the implied bit for |y| in [1, 2)), all bits below are fractional.
+	// |y| >= 2^24 (including Inf) is always an even integer
+	int_t unitPosition = 23 - clamp(yExponent, 0, 23);
+	int_t isInteger = yExponent >= 0 && (yBits & ((1 << unitPosition) - 1)) == 0;
+	int_t isOdd = isInteger && yExponent < 24 && ((yBits >> unitPosition) & 1) != 0;
+	// the sign is applied to the special cases too, e.g. pow(-0, y) = -0 and pow(-Inf, y) = -Inf for odd y > 0
+	result = isOdd && signbit(x) ? -result : result;
+	result = x < 0.0f && !VC4CL_CHECK_INF(x) && !isInteger ? (result_t) nan(0) : result;
+
+	result = VC4CL_CHECK_NAN(y) ? y : result;
+	result = VC4CL_CHECK_NAN(x) ? x : result;
+	// pow(x, +-0) = 1 and pow(1, y) = 1 also for NaN arguments
+	return vc4cl_is_zero(y) || x == 1.0f ? (result_t) 1.0f : result;
 })
+#endif
 
 /**
  * Expected behavior:
@@ -1146,9 +1723,18 @@ COMPLEX_2(float, pow, float, x, float, y, {
  * pown(+-0, n) = +-0 for odd n and n > 0
  * pown(+-0, n) = 0 for even n and n > 0
  */
- // TODO is there a way to not need to calculate both versions? Or at least calculate both at once?!
-SIMPLE_2(float, pown, float, x, int, n,
-	n < 0 ? (1.0f / fast_pown(x, vc4cl_bitcast_uint(-n), 32)) : fast_pown(x, vc4cl_bitcast_uint(n), 32))
+COMPLEX_2(float, pown, float, x, int, n, {
+	// x^n = 2^(n * log2|x|) with the sign of x for odd n.
+	// n is split into two parts with at most 24 significant bits each to be converted exactly
+	result_t result = vc4cl_upper(vc4cl_exp2_extended(vc4cl_mul(vc4cl_add(vc4cl_itof(n & (int_t) 0xFFFFFF00),
+		vc4cl_itof(n & (int_t) 0xFF)), vc4cl_log2_extended(fabs(x)))));
+	// the extended precision logarithm does not handle x = 0 and x = Inf (with infinite logarithms)
+	result = vc4cl_is_zero(x) || VC4CL_CHECK_INF(x) ? (VC4CL_CHECK_INF(x) == (n > 0) ? (result_t) INFINITY : (result_t) 0.0f) : result;
+	// the lowest bit of n is shifted into the sign position
+	result = vc4cl_bitcast_float(vc4cl_bitcast_uint(result) ^ (vc4cl_bitcast_uint(x) & vc4cl_bitcast_uint(n << 31)));
+	result = n == 0 ? (result_t) 1.0f : result;
+	return VC4CL_CHECK_NAN(x) && n != 0 ? x : result;
+})
 
 /**
  * Expected behavior:
@@ -1166,49 +1752,79 @@ SIMPLE_2(float, pown, float, x, int, n,
  * powr(NaN, y) = NaN
  */
 //"Compute x to the power y, where x is >= 0."
-// x^y = e^(y * ln(x))
-SIMPLE_2(float, powr, float, x, float, y, exp(y *log(x)))
+#ifndef VC4CL_RELAXED_MATH
+COMPLEX_2(float, powr, float, x, float, y, {
+	// x^y = 2^(y * log2(x)), see vc4cl_pow_positive
+	result_t result = vc4cl_pow_positive(x, y);
+	// the logarithm does not handle x = 0 and x = Inf (with infinite logarithms)
+	result = vc4cl_is_zero(x) || VC4CL_CHECK_INF(x) ? ((x > 0.0f) == (y > 0.0f) ? (result_t) INFINITY : (result_t) 0.0f) : result;
+	result = x == 1.0f ? (result_t) 1.0f : result;
+	// NaN for x < 0, 0^0, Inf^0 and 1^Inf
+	int_t isUndefined = x < 0.0f || ((vc4cl_is_zero(x) || VC4CL_CHECK_INF(x)) && vc4cl_is_zero(y)) || (x == 1.0f && VC4CL_CHECK_INF(y));
+	result = isUndefined ? (result_t) nan(0) : result;
+	result = VC4CL_CHECK_NAN(y) ? y : result;
+	return VC4CL_CHECK_NAN(x) ? x : result;
+})
+#endif
+
+/*
+ * Calculates remainder(x, y) and stores the lowest 7 bits of the (rounded) integral quotient with the sign of x / y in
+ * the output parameter, see remainder and remquo.
+ */
+COMPLEX_3(float, vc4cl_remquo, float, x, float, y, __private int, *quo, {
+	arg1_t absY = fabs(y);
+	int_t quotient;
+	result_t result = vc4cl_fmod_positive(fabs(x), absY, &quotient);
+	// round the quotient to nearest (ties to even). |y| - r is exact for r >= |y| / 2 and larger than r otherwise
+	result_t other = absY - result;
+	int_t roundUp = result > other || (result == other && (quotient & 1) != 0);
+	result = roundUp ? result - absY : result;
+	quotient = (roundUp ? quotient + 1 : quotient) & 0x7F;
+	quotient = (vc4cl_bitcast_int(x) ^ vc4cl_bitcast_int(y)) < 0 ? -quotient : quotient;
+	result = vc4cl_bitcast_float(vc4cl_bitcast_uint(result) ^ (vc4cl_bitcast_uint(x) & 0x80000000));
+
+	int_t unchanged = vc4cl_is_zero(x) || VC4CL_CHECK_INF(y);
+	result = unchanged ? x : result;
+	quotient = unchanged ? 0 : quotient;
+	int_t isUndefined = VC4CL_CHECK_INF(x) || vc4cl_is_zero(y) || VC4CL_CHECK_NAN(x) || VC4CL_CHECK_NAN(y);
+	result = isUndefined ? (result_t) nan(0) : result;
+	*quo = isUndefined ? 0 : quotient;
+	result = VC4CL_CHECK_NAN(y) ? y : result;
+	return VC4CL_CHECK_NAN(x) ? x : result;
+})
 
 /**
  * Expected behavior:
  *
- * remainder(x, 0) = NaN or 0
+ * remainder(x, 0) = NaN
  * remainder(Inf, y) = NaN
  * remainder(x, Inf) = x
  */
 COMPLEX_2(float, remainder, float, x, float, y, {
-	// TODO correct?
-	result_t k = rint(x / y);
-	result_t result = x - k * y;
-
-	result = vc4cl_is_zero(y) ? (result_t)-nan(0) : result;
-	result = isinf(x) ? (result_t)nan(0) : result;
-	result = isnan(x) ? x : result;
-	return isnan(y) ? y : result;
+	int_t quotient;
+	return vc4cl_remquo(x, y, &quotient);
 })
 
 /**
  * Expected behavior:
  *
  * remquo(x, y, quo) = NaN, quo = 0 for x = +-Inf or y = 0 or x = NaN or y = NaN
- * exp2(-Inf) = 0
- * exp2(+Inf) = +Inf
+ * remquo(x, +-Inf, quo) = x, quo = 0
  */
-// taken from pocl (https://github.com/pocl/pocl/blob/master/lib/kernel/vecmathlib-pocl/remquo.cl)
 COMPLEX_3(float, remquo, float, x, float, y, __global int, *quo, {
-	result_t k = rint(x / y);
-	*quo = (vc4cl_ftoi(k) & 0x7F) * (1 - 2 * signbit(k));
-	return x - k * y;
+	int_t quotient;
+	result_t result = vc4cl_remquo(x, y, &quotient);
+	*quo = quotient;
+	return result;
 })
 COMPLEX_3(float, remquo, float, x, float, y, __local int, *quo, {
-	result_t k = rint(x / y);
-	*quo = (vc4cl_ftoi(k) & 0x7F) * (1 - 2 * signbit(k));
-	return x - k * y;
+	int_t quotient;
+	result_t result = vc4cl_remquo(x, y, &quotient);
+	*quo = quotient;
+	return result;
 })
 COMPLEX_3(float, remquo, float, x, float, y, __private int, *quo, {
-	result_t k = rint(x / y);
-	*quo = (vc4cl_ftoi(k) & 0x7F) * (1 - 2 * signbit(k));
-	return x - k * y;
+	return vc4cl_remquo(x, y, quo);
 })
 
 /**
@@ -1218,27 +1834,19 @@ COMPLEX_3(float, remquo, float, x, float, y, __private int, *quo, {
  */
 COMPLEX_1(float, rint, float, val, {
 	//" Round to nearest even integer. "
-	// round like round, but decides on nearest even for halfway cases
-	// TODO always round to nearest even (e.g. 0.4 to 2.0) or just for half-way cases?
-
-	// https://stackoverflow.com/questions/12279914/implement-ceil-in-c
-	// http://blog.frama-c.com/index.php?post/2013/05/02/nearbyintf1
-
-	int_t tooBig = isnan(val) || fabs(val) >= 0x1.0p23f;
-	// |val| < 2^23 fits into integer
-	int_t integer = vc4cl_ftoi(val);
-	result_t truncated = vc4cl_itof(integer);
-	// for negative numbers, truncated is larger than value, for positive it is smaller
-	result_t diff = val - truncated;
-	// -> if the |difference| is > 0.5, subtract/add 1
-	result_t correction = 0.0f + (diff < -0.5f ? (result_t)-1.0f : (result_t)0.0f) + (diff > 0.5f ? (result_t)1.0f : (result_t)0.0f);
-	// if the value is exactly the half, round to nearest even
-	int_t isHalfWay = diff == 0.5f || diff == -0.5f;
-	// if the truncated integer is even, use it. Otherwise (lsb of integer is 1) subtract/add 1
-	result_t halfWayCorrection = 0 + vc4cl_itof(integer & 1) * sign(val);
-	result_t result = truncated + correction + vc4cl_itof(isHalfWay) * halfWayCorrection;
-	// deciding here which value to return saves us up to two jumps
-	return tooBig ? val : result;
+	int_t bits = vc4cl_bitcast_int(val);
+	int_t exponent = ((bits >> 23) & 0xFF) - 127;
+	int_t mask = vc4cl_fraction_mask(bits);
+	// Adding half of the last integral digit (minus one, if that digit is even) to the magnitude carries over into the
+	// integral part for all values above the halfway point and for the halfway point of odd integers. For 1 <= |x| < 2,
+	// the last integral digit is the LSB of the exponent, which is also set.
+	int_t half = (int_t) 0x00400000 >> clamp(exponent, 0, 31);
+	int_t lastDigit = (bits >> (23 - clamp(exponent, 0, 23))) & 1;
+	int_t rounded = exponent >= 23 ? bits : (bits + half - 1 + lastDigit) & ~mask;
+	// |x| < 1 rounds to +-1 for |x| > 0.5 and to +-0 otherwise
+	int_t small = (bits & (int_t) 0x80000000) |
+		(exponent == -1 && (bits & (int_t) 0x007FFFFF) != 0 ? (int_t) 0x3F800000 : (int_t) 0);
+	return vc4cl_bitcast_float(exponent < 0 ? small : rounded);
 })
 
 /**
@@ -1251,9 +1859,19 @@ COMPLEX_1(float, rint, float, val, {
  * rootn(x, n) = NaN for x < 0 and n even
  * rootn(x, 0) = NaN
  */
-// TODO different algorithm?
-SIMPLE_2(float, rootn, float, x, int, y, pow(x, (arg0_t) 1.0f / vc4cl_itof(y)))
-// see: https://en.wikipedia.org/wiki/Nth_root_algorithm
+COMPLEX_2(float, rootn, float, x, int, y, {
+	// x^(1/y) = 2^(log2|x| / y) with the sign of x for odd y
+	arg0_t divisor = vc4cl_itof(y);
+	result_t result =
+		vc4cl_upper(vc4cl_exp2_extended(vc4cl_div(vc4cl_log2_extended(fabs(x)), vc4cl_extend(divisor))));
+	// the extended precision logarithm does not handle x = 0 and x = Inf (with infinite logarithms)
+	result = vc4cl_is_zero(x) || VC4CL_CHECK_INF(x) ? (VC4CL_CHECK_INF(x) == (y > 0) ? (result_t) INFINITY : (result_t) 0.0f) : result;
+	// the lowest bit of y is shifted into the sign position
+	result = vc4cl_bitcast_float(vc4cl_bitcast_uint(result) ^ (vc4cl_bitcast_uint(x) & vc4cl_bitcast_uint(y << 31)));
+	// rootn(x, n) = NaN for x < 0 and n even, rootn(x, 0) = NaN
+	result = (x < 0.0f && (y & 1) == 0) || y == 0 ? (result_t) nan(0) : result;
+	return VC4CL_CHECK_NAN(x) ? x : result;
+})
 
 /**
  * Expected behavior:
@@ -1265,69 +1883,58 @@ SIMPLE_2(float, rootn, float, x, int, y, pow(x, (arg0_t) 1.0f / vc4cl_itof(y)))
 COMPLEX_1(float, round, float, val, {
 	//" Return the integral value nearest to x rounding halfway cases away from zero, regardless of the current rounding
 	// direction. "
-
-	// https://stackoverflow.com/questions/12279914/implement-ceil-in-c
-	// http://blog.frama-c.com/index.php?post/2013/05/02/nearbyintf1
-	int_t tooBig = isnan(val) || fabs(val) >= 0x1.0p23f;
-	// |val| < 2^23 fits into integer
-	result_t truncated = vc4cl_itof(vc4cl_ftoi(val));
-	// for negative numbers, truncated is larger than value, for positive it is smaller
-	result_t diff = val - truncated;
-	// -> if the |difference| is >= 0.5, subtract/add 1
-	result_t correction = 0.0f + (diff <= -0.5f ? (result_t)-1.0f : (result_t)0.0f) + (diff >= 0.5f ? (result_t)1.0f : (result_t)0.0f);
-	result_t result = truncated + correction;
-	// deciding here which value to return saves us up to two jumps
-	return tooBig ? val : result;
+	int_t bits = vc4cl_bitcast_int(val);
+	int_t exponent = ((bits >> 23) & 0xFF) - 127;
+	int_t mask = vc4cl_fraction_mask(bits);
+	// Adding half of the last integral digit to the magnitude carries over into the integral part for all values from
+	// the halfway point on
+	int_t half = (int_t) 0x00400000 >> clamp(exponent, 0, 31);
+	int_t rounded = (bits + half) & ~mask;
+	// |x| < 1 rounds to +-1 for |x| >= 0.5 and to +-0 otherwise
+	int_t small = (bits & (int_t) 0x80000000) | (exponent == -1 ? (int_t) 0x3F800000 : (int_t) 0);
+	return vc4cl_bitcast_float(exponent < 0 ? small : rounded);
 })
 
+/*
+ * Refines the approximation y of 1 / sqrt(x) with a single Newton-Raphson step, which doubles the number of correct
+ * bits: y' = y + y * (1 - x * y^2) / 2
+ *
+ * The square root functions are provided in tiers of accuracy, which all are seeded with the SFU approximation:
+ * - native_rsqrt/native_sqrt: the SFU approximation only (1 SFU operation, 1 multiplication for the square root)
+ * - half_rsqrt/half_sqrt: 1 Newton-Raphson step (+4 operations)
+ * - rsqrt: 2 Newton-Raphson steps (+8 operations)
+ * - sqrt: 2 Newton-Raphson steps and a correction with the exact remainder x - sqrt(x)^2 (+~25 operations), which
+ *   gives the correctly rounded result
+ *
+ * Max error (tested on host for all normal values, with a simulated SFU approximation with a relative error of 2^-11):
+ * - 8 ULP for half_rsqrt and half_sqrt
+ * - 1 ULP for rsqrt
+ * - 0 ULP (correctly rounded) for sqrt
+ */
+SIMPLE_2(float, vc4cl_rsqrt_step, float, x, float, y, y + y * (0.5f - x * y * (0.5f * y)))
+
+/**
+ * Expected behavior:
+ *
+ * rsqrt(+-0) = +-Inf
+ * rsqrt(+Inf) = +0
+ * rsqrt(x) = NaN for x < 0
+ */
+#ifndef VC4CL_RELAXED_MATH
 COMPLEX_1(float, rsqrt, float, x, {
-	// Using Goldschmidt's algorithm with 2 iterations
-	// see http://www.informatik.uni-trier.de/Reports/TR-08-2004/rnc6_12_markstein.pdf (formula 9)
-	arg_t y = vc4cl_sfu_rsqrt(x);
-	arg_t g = x * y;
-	arg_t h = y * (arg_t)0.5f;
-
-	for(unsigned i = 0; i < 2; ++i) {
-		arg_t r = (arg_t)0.5f - g * h;
-		g = g + g * r;
-		h = h + h * r;
-	}
+	arg_t y = vc4cl_rsqrt_step(x, vc4cl_rsqrt_step(x, vc4cl_sfu_rsqrt(x)));
 
 	// rsqrt(+-0) = +-Inf
-	result_t result = vc4cl_is_zero(x) ? copysign((result_t)INFINITY, x) : (arg_t)2.0f * h;
+	result_t result = vc4cl_is_zero(x) ? copysign((result_t)INFINITY, x) : y;
 	// rsqrt(NaN) = NaN
-	result = isnan(x) ? x : result;
+	result = VC4CL_CHECK_NAN(x) ? x : result;
 	// rsqrt(Inf) = 0
-	result = isinf(x) ? (result_t)0.0f : result;
+	result = VC4CL_CHECK_INF(x) ? (result_t)0.0f : result;
 	// rsqrt(x) for x < 0 = -NaN
 	result = x < (result_t)0.0f ? copysign((result_t)nan(0), -1.0f) : result;
 	return result;
 })
-
-COMPLEX_1(float, sin_pade, float, val, {
-	/*
-	 * Pade approximation
-	 * (https://en.wikipedia.org/wiki/Pad%C3%A9_approximant#Examples)
-	 *
-	 * Has a relative error of less than 2^23 (1 ULP) for range [-PI/2, PI/2], then rises fast
-	 *
-	 * Alternative:
-	 * Mendenhall algorithm to calculate both sine and cosine:
-	 * - Is also exact enough for range [-PI/2, PI/2]
-	 * - https://arxiv.org/pdf/cs/0406049.pdf
-	 * -
-	 * https://github.com/broadcomCM/android_hardware_broadcom_brcm_usrlib/blob/ics/dag/vmcsx/middleware/khronos/glsl/glsl_mendenhall.c
-	 */
-	arg_t a = 12671.0f / 4363920.0f;
-	arg_t b = 2363.0f / 18183.0f;
-	arg_t c = 445.0f / 12122.0f;
-	arg_t d = 601.0f / 872784.0f;
-	arg_t e = 121.0f / 16662240.0f;
-
-	arg_t up = (a * val * val * val * val * val) - (b * val * val * val) + val;
-	arg_t down = 1.0f + (c * val * val) + (d * val * val * val * val) + (e * val * val * val * val * val * val);
-	return up / down;
-})
+#endif
 
 COMPLEX_1(float, sin_fast, float, x, {
 	/*
@@ -1363,34 +1970,65 @@ COMPLEX_1(float, sin_fast, float, x, {
  * sin(+-0) = +-0
  * sin(+-Inf) = NaN for |x| > 1
  */
+#ifdef VC4CL_RELAXED_MATH
+SIMPLE_1(float, sin, float, val, half_sin(val))
+#elif VC4CL_ALLOWS_ULP(8192)
+COMPLEX_1(float, sin, float, val, {
+	result_t result = half_sin(val);
+	// MSB of the difference is set, if the value is larger than 2^16 (or Inf), for which the reduction of half_sin is no
+	// longer exact, see vc4cl_sincos_fast
+	if(any((int_t) 0x47800000 - vc4cl_bitcast_int(fabs(val))))
+	{
+		int_t quadrant;
+		result_t exact = vc4cl_trig_sin(vc4cl_trig_reduce(fabs(val), &quadrant), &quadrant);
+		exact = vc4cl_bitcast_float(vc4cl_bitcast_uint(exact) ^ (vc4cl_bitcast_uint(val) & 0x80000000));
+		result = fabs(val) > (arg_t) 0x1.0p16f ? exact : result;
+	}
+	return result;
+})
+#else
 COMPLEX_1(float, sin, float, val, {
 	/*
 	 * OpenCL 1.2 EMBEDDED PROFILE allows an error of up to 4 ulp
 	 *
-	 * We use argument reduction to bring it into range [-pi/2, pi/2] in which range the Pade approximation is accurate.
+	 * We use argument reduction to bring it into range [-pi/4, pi/4] in which range the polynomial approximation is
+	 * accurate. Since sine is an odd function, the reduction only needs to handle positive values and the sign of the
+	 * argument is applied to the result (which also handles sin(-0) = -0).
+	 * Inf and NaN result in NaN in the argument reduction.
 	 */
-	// TODO normalization into [-pi/2, pi/2] is too inaccurate for large values! fmod too inaccurate (~8 ULP, should be 0)
-
-	// Since sine has a period of 2pi, these rewrites do not change the result (rounding error excluded):
-	// bring into range [-2pi, 2pi]
-	arg_t modifiedVal = fmod(val, 2.0f * M_PI_F);
-	// bring into range [-pi, pi]
-	modifiedVal = modifiedVal < -M_PI_F ? modifiedVal + (2.0f * M_PI_F) : modifiedVal;
-	modifiedVal = modifiedVal > M_PI_F ? modifiedVal - (2.0f * M_PI_F) : modifiedVal;
-
-	// We move by half a period, so we must invert the sign of the result
-	// bring into range [-pi/2, pi/2]
-	int_t invertSign = modifiedVal < -M_PI_2_F || modifiedVal > M_PI_2_F;
-	modifiedVal = modifiedVal < -M_PI_2_F ? modifiedVal + M_PI_F : modifiedVal;
-	modifiedVal = modifiedVal > M_PI_2_F ? modifiedVal - M_PI_F : modifiedVal;
-
-	arg_t result = sin_pade(modifiedVal);
-	return invertSign ? -result : result;
+	int_t quadrant;
+	result_t result = vc4cl_trig_sin(vc4cl_trig_reduce(fabs(val), &quadrant), &quadrant);
+	return vc4cl_bitcast_float(vc4cl_bitcast_uint(result) ^ (vc4cl_bitcast_uint(val) & 0x80000000));
+})
+#endif
+
+COMPLEX_2(float, sincos, float, x, __global float, *cosval, {
+	// Shares the argument reduction, quadrant selection and the powers of the reduced argument, see sin and cos
+	int_t quadrant;
+	result_t cosine;
+	result_t sine = vc4cl_trig_sincos(vc4cl_trig_reduce(fabs(x), &quadrant), &quadrant, &cosine);
+	// cosine is an even function, sine an odd one
+	*cosval = cosine;
+	return vc4cl_bitcast_float(vc4cl_bitcast_uint(sine) ^ (vc4cl_bitcast_uint(x) & 0x80000000));
+})
+COMPLEX_2(float, sincos, float, x, __local float, *cosval, {
+	// Shares the argument reduction, quadrant selection and the powers of the reduced argument, see sin and cos
+	int_t quadrant;
+	result_t cosine;
+	result_t sine = vc4cl_trig_sincos(vc4cl_trig_reduce(fabs(x), &quadrant), &quadrant, &cosine);
+	// cosine is an even function, sine an odd one
+	*cosval = cosine;
+	return vc4cl_bitcast_float(vc4cl_bitcast_uint(sine) ^ (vc4cl_bitcast_uint(x) & 0x80000000));
+})
+COMPLEX_2(float, sincos, float, x, __private float, *cosval, {
+	// Shares the argument reduction, quadrant selection and the powers of the reduced argument, see sin and cos
+	int_t quadrant;
+	result_t cosine;
+	result_t sine = vc4cl_trig_sincos(vc4cl_trig_reduce(fabs(x), &quadrant), &quadrant, &cosine);
+	// cosine is an even function, sine an odd one
+	*cosval = cosine;
+	return vc4cl_bitcast_float(vc4cl_bitcast_uint(sine) ^ (vc4cl_bitcast_uint(x) & 0x80000000));
 })
-
-SIMPLE_2(float, sincos, float, x, __global float, *cosval, (*cosval = cos(x), sin(x)))
-SIMPLE_2(float, sincos, float, x, __local float, *cosval, (*cosval = cos(x), sin(x)))
-SIMPLE_2(float, sincos, float, x, __private float, *cosval, (*cosval = cos(x), sin(x)))
 
 /**
  * Expected behavior:
@@ -1399,77 +2037,18 @@ SIMPLE_2(float, sincos, float, x, __private float, *cosval, (*cosval = cos(x), s
  * sinh(+-Inf) = +-Inf
  */
 COMPLEX_1(float, sinh, float, val, {
-	/*
-	 * https://en.wikipedia.org/wiki/Taylor_series#Approximation_and_convergence
-	 *
-	 * This version (the Taylor-series up to x^17/17!) has following accuracy:
-	 *
-	 * sinh(PI) -> error of 2*10^-8 < ulp(PI) = 2*10^-7
-	 * sinh(0.5f) -> error of < 10^-10 < ulp(0.5f) = 5*10^-8
-	 * sinh(0.0f) -> error of < 10^-48 < ulp(0.0f) = 1*10^-45
-	 *
-	 * OpenCL 1.2 EMBEDDED PROFILE allows an error of up to 4 ulp
-	 */
-	// TODO inaccurate out of the range of -PI <= x <= PI
-	/*
-	 * Alternatives:
-	 * sinh(x) = sqrt((cosh(2x)-1)/2)
-	 * sinh(x) = exp(x) - cosh(x)
-	 */
-	const result_t fac3 = 1.0f / factorial(3);
-	const result_t fac5 = 1.0f / factorial(5);
-	const result_t fac7 = 1.0f / factorial(7);
-	const result_t fac9 = 1.0f / factorial(9);
-	const result_t fac11 = 1.0f / factorial(11);
-	const result_t fac13 = 1.0f / factorial(13);
-	const result_t fac15 = 1.0f / factorial(15);
-	const result_t fac17 = 1.0f / factorial(17);
-
-	result_t x = val;
-	/// TODO optimize!!
-	/*
-	while(x < -M_PI_F)
-	{
-	x = x + 2 * M_PI_F;
-	}
-	while(x > M_PI_F)
-	{
-	x = x - 2 * M_PI_F;
-	}
-	 */
-	result_t x3 = x * x * x;
-	result_t tmp1 = x3 * fac3;
-	// sinh(x) = x + x^3/3! + ...
-	result_t tmp = x + tmp1;
-	result_t x5 = x3 * x * x;
-	tmp1 = x5 * fac5;
-	//... + x^5/5! + ...
-	tmp = x + tmp1;
-	result_t x7 = x5 * x * x;
-	tmp1 = x7 * fac7;
-	//... + x^7/7! + ...
-	tmp = tmp + tmp1;
-	result_t x9 = x7 * x * x;
-	tmp1 = x9 * fac9;
-	//... + x^9/9! + ...
-	tmp = tmp + tmp1;
-	result_t x11 = x9 * x * x;
-	tmp1 = x11 * fac11;
-	//... + x^11/11! + ...
-	tmp = tmp + tmp1;
-	result_t x13 = x11 * x * x;
-	tmp1 = x13 * fac13;
-	//... + x^13/13! + ...
-	tmp = tmp + tmp1;
-	result_t x15 = x13 * x * x;
-	tmp1 = x15 * fac15;
-	//... + x^15/15! + ...
-	tmp = tmp + tmp1;
-	result_t x17 = x15 * x * x;
-	tmp1 = x17 * fac17;
-	//... + x^17/17!
-	tmp = tmp + tmp1;
-	return tmp;
+	// For |x| < 1, sinh(x) = x + x^3 * P(x^2) with a minimax polynomial of degree 2 (relative error < 2^-25).
+	// Otherwise sinh(x) = (e^x - e^-x) / 2 = (u + u / (u + 1)) / 2 with u = e^x - 1, which has no cancellation.
+	// Max error (tested on host): 2 ULP
+	arg_t absVal = fabs(val);
+	arg_t x2 = absVal * absVal;
+	result_t small = absVal + absVal * x2 * (1.6666717827e-01f + x2 * (8.3302110434e-03f + x2 * 2.0377401961e-04f));
+	arg_t u = vc4cl_sub_one(vc4cl_exp_hyperbolic(absVal));
+	// for x > 88, u is e^x / 2 (see vc4cl_exp_hyperbolic)
+	result_t result = absVal > (arg_t) 88.0f ? u : 0.5f * (u + u / (u + 1.0f));
+	result = absVal < (arg_t) 1.0f ? small : result;
+	result = vc4cl_bitcast_float(vc4cl_bitcast_uint(result) | (vc4cl_bitcast_uint(val) & 0x80000000));
+	return VC4CL_CHECK_NAN(val) ? val : result;
 })
 
 /**
@@ -1480,28 +2059,46 @@ COMPLEX_1(float, sinh, float, val, {
  * sinpi(n) = -0 for n integer and n < 0
  * sinpi(+-Inf) = NaN
  */
-SIMPLE_1(float, sinpi, float, val, sin(val *M_PI_F))
+COMPLEX_1(float, sinpi, float, val, {
+	// The reduction of the pi-scaled argument is exact, so there is no error introduced by multiplying with pi first
+	int_t quadrant;
+	result_t result = vc4cl_trig_sin(vc4cl_trig_reduce_pi(fabs(val), &quadrant), &quadrant);
+	// -0 + +0 = +0, converts the zero result for integral values to +0, the sign is then applied below
+	result = result + 0.0f;
+	return vc4cl_bitcast_float(vc4cl_bitcast_uint(result) ^ (vc4cl_bitcast_uint(val) & 0x80000000));
+})
+
+// Calculates x - y for y close to x, the subtraction of the upper part is exact, see also vc4cl_sub_one
+SIMPLE_2(float, vc4cl_sub_close, float, x, FloatFloat, y, (x - vc4cl_upper(y)) - vc4cl_lower(y))
 
+/**
+ * Expected behavior:
+ *
+ * sqrt(+-0) = +-0
+ * sqrt(+Inf) = +Inf
+ * sqrt(x) = NaN for x < 0
+ */
+#ifndef VC4CL_RELAXED_MATH
 COMPLEX_1(float, sqrt, float, x, {
-	// Using Goldschmidt's algorithm with 2 iterations
-	// see http://www.informatik.uni-trier.de/Reports/TR-08-2004/rnc6_12_markstein.pdf (formula 9)
-	arg_t y = vc4cl_sfu_rsqrt(x);
-	arg_t g = x * y;
-	arg_t h = y * (arg_t)0.5f;
-
-	for(unsigned i = 0; i < 2; ++i) {
-		arg_t r = (arg_t)0.5f - g * h;
-		g = g + g * r;
-		h = h + h * r;
-	}
+	// See vc4cl_rsqrt_step for the accuracy tiers.
+	// Arguments are scaled where the exact square of the result would overflow or have a subnormal lower part
+	int_t small = x < (arg_t) 0x1.0p-100f;
+	int_t large = x > (arg_t) 0x1.0p126f;
+	arg_t scaled = x * (small ? (arg_t) 0x1.0p64f : large ? (arg_t) 0.25f : (arg_t) 1.0f);
+	arg_t y = vc4cl_rsqrt_step(scaled, vc4cl_rsqrt_step(scaled, vc4cl_sfu_rsqrt(scaled)));
+	arg_t g = scaled * y;
+	// sqrt(x) = g + (x - g^2) / (2 * sqrt(x)) ~ g + (x - g^2) * y / 2 with the exact remainder x - g^2
+	arg_t remainder = vc4cl_sub_close(scaled, vc4cl_mul(g, g));
+	result_t result = (g + remainder * (0.5f * y)) * (small ? (arg_t) 0x1.0p-32f : large ? (arg_t) 2.0f : (arg_t) 1.0f);
 
 	// sqrt(NaN) = NaN, sqrt(Inf) = Inf
-	result_t result = vc4cl_is_inf_nan(x) ? x : g;
+	result = VC4CL_CHECK_INF_NAN(x) ? x : result;
 	// sqrt(+-0) = +-0
 	result = vc4cl_is_zero(x) ? x : result;
 	// sqrt(x) = NaN, for x < 0
 	return x < 0.0f ? (result_t)nan(0) : result;
 })
+#endif
 
 /**
  * Expected behavior:
@@ -1509,19 +2106,38 @@ COMPLEX_1(float, sqrt, float, x, {
  * tan(+-0) = +-0
  * tan(+-Inf) = NaN
  */
-// TODO different algorithm?!
-// Taylor Series is too inaccurate (converges too slow)
-SIMPLE_1(float, tan, float, val, sin(val) / cos(val))
+#ifndef VC4CL_RELAXED_MATH
+COMPLEX_1(float, tan, float, val, {
+	// Since tangent is an odd function, the reduction only needs to handle positive values
+	int_t quadrant;
+	result_t result = vc4cl_trig_tan(vc4cl_trig_reduce(fabs(val), &quadrant), &quadrant);
+	return vc4cl_bitcast_float(vc4cl_bitcast_uint(result) ^ (vc4cl_bitcast_uint(val) & 0x80000000));
+})
+#endif
 
 /**
  * Expected behavior:
  *
  * tanh(+-0) = +-0
- * tanh(+-Inf) = +-Inf
+ * tanh(+-Inf) = +-1
  */
-// TODO different algorithm?!
-// Taylor Series is too inaccurate (converges too slow)
-SIMPLE_1(float, tanh, float, val, sinh(val) / cosh(val))
+COMPLEX_1(float, tanh, float, val, {
+	// For |x| < 0.55, tanh(x) = x + x^3 * P(x^2) with a minimax polynomial of degree 4 (relative error < 2^-29).
+	// Otherwise tanh(x) = u / (u + 2) with u = e^2x - 1, which is only a single evaluation of the exponential function
+	// and a single division. For |x| > 10, tanh(x) rounds to 1.
+	// Max error (tested on host): 2 ULP
+	arg_t absVal = fabs(val);
+	arg_t x2 = absVal * absVal;
+	result_t small = absVal +
+		absVal * x2 *
+			(-3.3333319426e-01f +
+				x2 * (1.3332602382e-01f + x2 * (-5.3853858262e-02f + x2 * (2.1077765152e-02f + x2 * -6.2824808992e-03f))));
+	arg_t u = vc4cl_sub_one(vc4cl_exp_hyperbolic(fmin(absVal, (arg_t) 10.0f) * 2.0f));
+	result_t result = u / (u + 2.0f);
+	result = absVal < (arg_t) 0.55f ? small : result;
+	result = vc4cl_bitcast_float(vc4cl_bitcast_uint(result) | (vc4cl_bitcast_uint(val) & 0x80000000));
+	return VC4CL_CHECK_NAN(val) ? val : result;
+})
 
 /**
  * Expected behavior:
@@ -1533,7 +2149,16 @@ SIMPLE_1(float, tanh, float, val, sinh(val) / cosh(val))
  * tanpi(x) = +Inf for x = n + 0.5 and n even integer
  * tanpi(x) = -Inf for x = n + 0.5 and n odd integer
  */
-SIMPLE_1(float, tanpi, float, val, tan(val *M_PI_F))
+COMPLEX_1(float, tanpi, float, val, {
+	// The reduction of the pi-scaled argument is exact, so there is no error introduced by multiplying with pi first
+	int_t quadrant;
+	result_t result = vc4cl_trig_tan(vc4cl_trig_reduce_pi(fabs(val), &quadrant), &quadrant);
+	// for (half-)integral values the reduced argument is +0, which gives the wrong signs for tanpi(n) = -0 with n odd
+	// (quadrant 2) and tanpi(n + 0.5) = +Inf with n even (quadrant 1)
+	int_t invertSign = (result == 0.0f || isinf(result)) && (quadrant == 1 || quadrant == 2);
+	result = invertSign ? -result : result;
+	return vc4cl_bitcast_float(vc4cl_bitcast_uint(result) ^ (vc4cl_bitcast_uint(val) & 0x80000000));
+})
 
 /**
  * Expected behavior:
@@ -1543,9 +2168,17 @@ SIMPLE_1(float, tanpi, float, val, tan(val *M_PI_F))
  * tgamma(-Inf) = NaN
  * tgamma(+Inf) = +Inf
  */
-// TODO different algorithm?! E.g. http://www.math.hkbu.edu.hk/support/aands/page_257.htm with argument reduction
-// (previous page)
-SIMPLE_1(float, tgamma, float, val, exp(lgamma(val)))
+COMPLEX_1(float, tgamma, float, val, {
+	// gamma(x) = +-2^log2(|gamma(x)|), the exponent is calculated in extended precision
+	int_t sign;
+	result_t result = vc4cl_upper(vc4cl_exp2_extended(vc4cl_log2_gamma(val, &sign)));
+	result = sign < 0 ? -result : result;
+	result = val == INFINITY ? val : result;
+	// the poles at x < 0 and x integer (including -Inf) have no defined sign
+	result = val < 0.0f && trunc(val) == val ? (result_t) nan(0) : result;
+	result = vc4cl_is_zero(val) ? copysign((result_t) INFINITY, val) : result;
+	return VC4CL_CHECK_NAN(val) ? val : result;
+})
 
 /**
  * Expected behavior:
@@ -1556,19 +2189,16 @@ SIMPLE_1(float, tgamma, float, val, exp(lgamma(val)))
  */
 COMPLEX_1(float, trunc, float, val, {
 	//"  Round to integer toward zero.  "
-	// https://stackoverflow.com/questions/12279914/implement-ceil-in-c
-	// http://blog.frama-c.com/index.php?post/2013/05/02/nearbyintf1
-	int_t tooBig = isnan(val) || fabs(val) >= 0x1.0p23f;
-	// |val| < 2^23 fits into integer
-	result_t truncated = vc4cl_itof(vc4cl_ftoi(val));
-	// deciding here which value to return saves us up to two jumps
-	return tooBig ? val : truncated;
+	int_t bits = vc4cl_bitcast_int(val);
+	return vc4cl_bitcast_float(bits & ~vc4cl_fraction_mask(bits));
 })
 
 /*
  * native functions
  */
-SIMPLE_1(float, native_cos, float, val, cos(val))
+// There are no SFU instructions for the trigonometric functions, so the native versions use the same fast
+// approximations as the half versions
+SIMPLE_1(float, native_cos, float, val, half_cos(val))
 
 SIMPLE_2(float, native_divide, float, x, float, y, x *native_recip(y))
 
@@ -1595,16 +2225,22 @@ SIMPLE_2(float, native_powr, float, x, float, y, native_exp2(y *native_log2(x)))
 SIMPLE_1(float, native_recip, float, val, vc4cl_sfu_recip(val))
 SIMPLE_1(float, native_rsqrt, float, val, vc4cl_sfu_rsqrt(val))
 
-SIMPLE_1(float, native_sin, float, val, sin(val))
+SIMPLE_1(float, native_sin, float, val, half_sin(val))
 
 SIMPLE_1(float, native_sqrt, float, val, val * vc4cl_sfu_rsqrt(val))
 
-SIMPLE_1(float, native_tan, float, val, tan(val))
+SIMPLE_1(float, native_tan, float, val, half_tan(val))
 
 /*
  * half functions, accuracy of 8192 ULP (11 MSB of the mantissa)
  */
-SIMPLE_1(float, half_cos, float, val, cos(val))
+COMPLEX_1(float, half_cos, float, val, {
+	int_t quadrant;
+	result_t cosine;
+	result_t sine = vc4cl_sincos_fast(val, &quadrant, &cosine);
+	result_t result = (quadrant & 1) != 0 ? -sine : cosine;
+	return (quadrant & 2) != 0 ? -result : result;
+})
 SIMPLE_2(float, half_divide, float, x, float, y, x * vc4cl_sfu_recip(y))
 SIMPLE_1(float, half_exp, float, val, native_exp(val))
 COMPLEX_1(float, half_exp2, float, val, {
@@ -1613,7 +2249,7 @@ COMPLEX_1(float, half_exp2, float, val, {
 	result = vc4cl_is_zero(val) ? (result_t)1.0f : result;
 	result = val < (result_t)-126.0f ? (result_t)0.0f : result;
 	result = val >= (result_t)128.0f ? (result_t)INFINITY : result;
-	return isnan(val) ? val : result;
+	return VC4CL_CHECK_NAN(val) ? val : result;
 })
 SIMPLE_1(float, half_exp10, float, val, native_exp10(val))
 SIMPLE_1(float, half_log, float, val, native_log(val))
@@ -1629,7 +2265,7 @@ COMPLEX_1(float, half_log2, float, val, {
 	result_t logMantissa = vc4cl_sfu_log2(mantissa);
 
 	result_t result = vc4cl_itof(exponent) + logMantissa;
-	result = vc4cl_is_inf_nan(val) ? val : result;
+	result = VC4CL_CHECK_INF_NAN(val) ? val : result;
 	result = signbit(val) ? (result_t)nan(0) : result;
 	result = vc4cl_is_zero(val) ? (result_t)-INFINITY: result;
 	return result;
@@ -1638,29 +2274,70 @@ SIMPLE_1(float, half_log10, float, val, native_log10(val))
 SIMPLE_2(float, half_powr, float, x, float, y, powr(x, y))
 SIMPLE_1(float, half_recip, float, val, (arg_t)1.0f / val)
 COMPLEX_1(float, half_rsqrt, float, val, {
-	arg_t x = vc4cl_sfu_rsqrt(val);
+	arg_t x = vc4cl_rsqrt_step(val, vc4cl_sfu_rsqrt(val));
 
 	// rsqrt(+-0) = +-Inf
 	result_t result = vc4cl_is_zero(val) ? copysign((result_t)INFINITY, val) : x;
 	// rsqrt(NaN) = NaN
-	result = isnan(val) ? val : result;
+	result = VC4CL_CHECK_NAN(val) ? val : result;
 	// rsqrt(Inf) = 0
-	result = isinf(val) ? (result_t)0.0f : result;
+	result = VC4CL_CHECK_INF(val) ? (result_t)0.0f : result;
 	// rsqrt(x) for x < 0 = -NaN
 	result = val < (result_t)0.0f ? copysign((result_t)nan(0), -1.0f) : result;
 	return result;
 })
-SIMPLE_1(float, half_sin, float, val, sin(val))
+COMPLEX_1(float, half_sin, float, val, {
+	int_t quadrant;
+	result_t cosine;
+	result_t sine = vc4cl_sincos_fast(val, &quadrant, &cosine);
+	result_t result = (quadrant & 1) != 0 ? cosine : sine;
+	return (quadrant & 2) != 0 ? -result : result;
+})
 COMPLEX_1(float, half_sqrt, float, val, {
-	arg_t x = val * vc4cl_sfu_rsqrt(val);
+	arg_t x = val * vc4cl_rsqrt_step(val, vc4cl_sfu_rsqrt(val));
 
 	// sqrt(NaN) = NaN, sqrt(Inf) = Inf
-	result_t result = vc4cl_is_inf_nan(val) ? val : x;
+	result_t result = VC4CL_CHECK_INF_NAN(val) ? val : x;
 	// sqrt(+-0) = +-0
 	result = vc4cl_is_zero(val) ? val : result;
 	// sqrt(x) = NaN, for x < 0
 	return val < 0.0f ? (result_t)nan(0) : result;
 })
-SIMPLE_1(float, half_tan, float, val, tan(val))
+COMPLEX_1(float, half_tan, float, val, {
+	int_t quadrant;
+	result_t cosine;
+	result_t sine = vc4cl_sincos_fast(val, &quadrant, &cosine);
+	// tan(x + pi/2) = -cos(x) / sin(x), tan(x + pi) = tan(x)
+	int_t odd = (quadrant & 1) != 0;
+	result_t numerator = odd ? -cosine : sine;
+	result_t denominator = odd ? sine : cosine;
+	return numerator * vc4cl_sfu_recip(denominator);
+})
+
+#ifdef VC4CL_RELAXED_MATH
+/*
+ * Relaxed math mode, the full precision functions use the SFU based native_ versions. exp, log, sin and cos select
+ * their native_ (or half_) versions via the accuracy tiers (see VC4CL_ALLOWS_ULP).
+ */
+SIMPLE_1(float, exp2, float, val, native_exp2(val))
+SIMPLE_1(float, exp10, float, val, native_exp10(val))
+SIMPLE_1(float, log2, float, val, native_log2(val))
+SIMPLE_1(float, log10, float, val, native_log10(val))
+COMPLEX_2(float, pow, float, x, float, y, {
+	// x^y = |x|^y with a negative sign for negative x and odd integral y
+	result_t result = native_powr(fabs(x), y);
+	int_t isOddInteger = trunc(y) == y && fabs(y) < 0x1.0p24f && (vc4cl_ftoi(y) & 1) != 0;
+	return x < 0.0f && isOddInteger ? -result : result;
+})
+SIMPLE_2(float, powr, float, x, float, y, native_powr(x, y))
+SIMPLE_1(float, rsqrt, float, val, native_rsqrt(val))
+// native_sqrt(+-0) = 0 * Inf = NaN
+SIMPLE_1(float, sqrt, float, val, vc4cl_is_zero(val) ? val : native_sqrt(val))
+SIMPLE_1(float, tan, float, val, native_tan(val))
+#endif
+
+#undef VC4CL_CHECK_NAN
+#undef VC4CL_CHECK_INF
+#undef VC4CL_CHECK_INF_NAN
 
 #endif /* VC4CL_MATH_H */
@@ -629,6 +629,61 @@
 	}
 #endif
 
+#ifndef COMPLEX_2_SCALAR
+#define COMPLEX_2_SCALAR(ret, func, argType0, argName0, argType1, argName1, content) \
+	INLINE FUNC_2(ret##16, func, argType0##16, argName0, argType1, argName1) \
+	{ \
+		typedef argType0##16 arg0_t;\
+		typedef argType1 arg1_t;\
+		typedef ret##16 result_t;\
+		typedef int##16 int_t; \
+		typedef uint##16 uint_t; \
+		typedef float##16 float_t; \
+		content \
+	} \
+	INLINE FUNC_2(ret##8, func, argType0##8, argName0, argType1, argName1) \
+	{ \
+		typedef argType0##8 arg0_t;\
+		typedef argType1 arg1_t;\
+		typedef ret##8 result_t;\
+		typedef int##8 int_t; \
+		typedef uint##8 uint_t; \
+		typedef float##8 float_t; \
+		content \
+	} \
+	INLINE FUNC_2(ret##4, func, argType0##4, argName0, argType1, argName1) \
+	{ \
+		typedef argType0##4 arg0_t;\
+		typedef argType1 arg1_t;\
+		typedef ret##4 result_t;\
+		typedef int##4 int_t; \
+		typedef uint##4 uint_t; \
+		typedef float##4 float_t; \
+		content \
+	} \
+	INLINE FUNC_2(ret##3, func, argType0##3, argName0, argType1, argName1) \
+	{ \
+		typedef argType0##3 arg0_t;\
+		typedef argType1 arg1_t;\
+		typedef ret##3 result_t;\
+		typedef int##3 int_t; \
+		typedef uint##3 uint_t; \
+		typedef float##3 float_t; \
+		content \
+	} \
+	INLINE FUNC_2(ret##2, func, argType0##2, argName0, argType1, argName1) \
+	{ \
+		typedef argType0##2 arg0_t;\
+		typedef argType1 arg1_t;\
+		typedef ret##2 result_t;\
+		typedef int##2 int_t; \
+		typedef uint##2 uint_t; \
+		typedef float##2 float_t; \
+		content \
+	} \
+	//scalar part is skipped, since it is too often already defined for e.g. a version taking two vectors
+#endif
+
 #ifndef COMPLEX_3
 #define COMPLEX_3(ret, func, argType0, argName0, argType1, argName1, argType2, argName2, content) \
 	INLINE FUNC_3(ret##16, func, argType0##16, argName0, argType1##16, argName1, argType2##16, argName2) \
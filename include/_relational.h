@@ -68,56 +68,30 @@
 #endif
 
 #ifndef FOR_ALL_ELEMENTS
-#define FOR_ALL_ELEMENTS(func, type, op, conv) \
+#define FOR_ALL_ELEMENTS(func, type, reduction, conv) \
 	INLINE FUNC_1(int, func, type##16, x) CONST \
 	{ \
-		/* (s0, s1, s2, s3, s4, s5, s6, s7, s8, s9, sa, sb, sc, sd, se, sf) */ \
-		type##16 val0 = conv(x); \
-		/* (s0 op s1, s1 op s2, s2 op s3, s3 op s4, s4 op s5, s5 op s6, s6 op s7, s7 op s8, s8 op s9, s9 op sa, sa op sb, sb op sc, sc op sd, sd op se, se op sf, sf op s0) */ \
-		val0 = val0 op vc4cl_vector_rotate(val0, -1); \
-		/* (s0 op s1 op s2 op s3, s1 op s2 op s3 op s4, s2 op s3 op s4 op s5, s3 op s4 op s5 op s6, s4 op s5 op s6 op s7, s5 op s6 op s7 op s8, s6 op s7 op s8 op s9, s7 op s8 op s9 op sa, s8 op s9 op sa op sb, s9 op sa op sb op sc, sa op sb op sc op sd, sb op sc op sd op se, sc op sd op se op sf, ...) */ \
-		const type##16 val1 = val0 op vc4cl_vector_rotate(val0, -2); \
-		/* (s0 op s1 op s2 op s3 op s4 op s5 op s6 op s7, ..., s8 op s9 op sa op ab op sc op sd op se op sf, ...) */ \
-		const type##16 val2 = val1 op vc4cl_vector_rotate(val1, -4); \
-		/* s0 op s1 op s2 op s3 op s4 op s5 op s6 op s7 op s8 op s9 op sa op ab op sc op sd op se op sf */ \
-		return (val2 op val1 op vc4cl_vector_rotate(val2, -8)).x != 0; \
+		return reduction(conv(x)) != 0; \
 	} \
 	INLINE FUNC_1(int, func, type##8, x) CONST \
 	{ \
-		/* (s0, s1, s2, s3, s4, s5, s6, s7) */ \
-		type##8 val0 = conv(x); \
-		/* (s0 op s1, s1 op s2, s2 op s3, s3 op s4, s4 op s5, s5 op s6, s6 op s7, s7 op ?) */ \
-		val0 = val0 op vc4cl_vector_rotate(val0, -1); \
-		/* (s0 op s1 op s2 op s3, s1 op s2 op s3 op s4, s2 op s3 op s4 op s5, s3 op s4 op s5 op s6, s4 op s5 op s6 op s7, s5 op s6 op s7 op ?, s6 op s7 op ? op ?, s7 op ? op ? op ?) */ \
-		const type##8 val1 = val0 op vc4cl_vector_rotate(val0, -2); \
-		/* s0 op s1 op s2 op s3 op s4 op s5 op s6 op s7 */ \
-		return (val1 op vc4cl_vector_rotate(val1, -4)).x != 0; \
+		return reduction(conv(x)) != 0; \
 	} \
 	INLINE FUNC_1(int, func, type##4, x) CONST \
 	{ \
-		/* (x, y, z, w) */ \
-		type##4 val0 = conv(x); \
-		/* (x op y, y op z, z op w, w op ?) */ \
-		val0 = val0 op vc4cl_vector_rotate(val0, -1); \
-		/* (z op w, w op ?, ? op ?, ? op ?) */ \
-		const type##4 val1 = vc4cl_vector_rotate(val0, -2); \
-		/* (x op y op z op w, ...) */ \
-		return (val0 op val1).x != 0; \
+		return reduction(conv(x)) != 0; \
 	} \
 	INLINE FUNC_1(int, func, type##3, x) CONST \
 	{ \
-		type##3 val = conv(x); \
-		return (val.x op val.y op val.z) != 0; \
+		return reduction(conv(x)) != 0; \
 	} \
 	INLINE FUNC_1(int, func, type##2, x) CONST \
 	{ \
-		type##2 val = conv(x); \
-		return (val.x op val.y) != 0; \
+		return reduction(conv(x)) != 0; \
 	} \
 	INLINE FUNC_1(int, func, type, x) CONST \
 	{ \
-		type val = conv(x); \
-		return val != 0; \
+		return reduction(conv(x)) != 0; \
 	}
 #endif
 
@@ -209,15 +183,15 @@ INLINE FUNC_1(int, signbit, float, val) CONST
        return vc4cl_bitcast_uint(val) >> 31;
 }
 
-FOR_ALL_ELEMENTS(any, char, |, vc4cl_msb_set)
-FOR_ALL_ELEMENTS(any, short, |, vc4cl_msb_set)
-FOR_ALL_ELEMENTS(any, int, |, vc4cl_msb_set)
-FOR_ALL_ELEMENTS(any, long, |, vc4cl_msb_set)
+FOR_ALL_ELEMENTS(any, char, vc4cl_reduce_or, vc4cl_msb_set)
+FOR_ALL_ELEMENTS(any, short, vc4cl_reduce_or, vc4cl_msb_set)
+FOR_ALL_ELEMENTS(any, int, vc4cl_reduce_or, vc4cl_msb_set)
+FOR_ALL_ELEMENTS(any, long, vc4cl_reduce_or, vc4cl_msb_set)
 
-FOR_ALL_ELEMENTS(all, char, &, vc4cl_msb_set)
-FOR_ALL_ELEMENTS(all, short, &, vc4cl_msb_set)
-FOR_ALL_ELEMENTS(all, int, &, vc4cl_msb_set)
-FOR_ALL_ELEMENTS(all, long, &, vc4cl_msb_set)
+FOR_ALL_ELEMENTS(all, char, vc4cl_reduce_and, vc4cl_msb_set)
+FOR_ALL_ELEMENTS(all, short, vc4cl_reduce_and, vc4cl_msb_set)
+FOR_ALL_ELEMENTS(all, int, vc4cl_reduce_and, vc4cl_msb_set)
+FOR_ALL_ELEMENTS(all, long, vc4cl_reduce_and, vc4cl_msb_set)
 
 
 //"Each bit of the result is the corresponding bit of a if the corresponding bit of c is 0.
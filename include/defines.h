@@ -80,6 +80,8 @@
 #define cl_arm_integer_dot_product_accumulate_int8 1
 #define cl_arm_integer_dot_product_accumulate_int16 1
 #define cl_arm_integer_dot_product_accumulate_saturate_int8 1
+#define cl_vc4cl_float_float 1
+#define cl_vc4cl_double 1
 
 // unsupported extensions or optional core features
 #undef cl_khr_fp16